@@ -0,0 +1,74 @@
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+#include <RandomEngine.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class AliasTable
+ * @brief Picks from a fixed discrete distribution in constant time.
+ *
+ * Built once from a list of weights with Vose's variant of Walker's alias
+ * method. Every entry owns a column of equal probability; the column keeps
+ * its entry for a fraction of draws and hands the rest to a single alias
+ * entry. A pick is one uniform column and one comparison, however many
+ * entries there are and however skewed the weights.
+ */
+class AliasTable
+{
+public:
+	/**
+	 * @brief Constructs an empty table.
+	 */
+	AliasTable() = default;
+
+	/**
+	 * @brief Builds the table for a list of weights.
+	 *
+	 * @param weights The weight of every entry. Entries with weight 0 are never
+	 *                picked, unless every weight is 0, in which case all entries
+	 *                are equally likely.
+	 * @param count The number of entries.
+	 */
+	AliasTable(const std::uint32_t* weights, std::size_t count);
+
+	/**
+	 * @brief Picks an entry with probability proportional to its weight.
+	 *
+	 * @param random The random engine.
+	 * @return The position of the entry. Must not be called on an empty table.
+	 */
+	[[nodiscard]] std::size_t pick(RandomEngine& random) const
+	{
+		const auto column = static_cast<std::size_t>(random.below(thresholds.size()));
+		return random() < thresholds[column] ? column : aliases[column];
+	}
+
+	/**
+	 * @return The number of entries.
+	 */
+	[[nodiscard]] std::size_t size() const { return thresholds.size(); }
+
+	/**
+	 * @return True if the table has no entries.
+	 */
+	[[nodiscard]] bool empty() const { return thresholds.empty(); }
+
+private:
+	/**
+	 * @brief A column keeps its own entry when a 64 bit draw is below its threshold.
+	 *
+	 * Full columns hold the maximum and alias themselves, so they always keep it.
+	 */
+	std::vector<std::uint64_t> thresholds;
+
+	/**
+	 * @brief The entry each column hands the rest of its draws to.
+	 */
+	std::vector<std::uint32_t> aliases;
+};
+
+#endif
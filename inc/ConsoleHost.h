@@ -0,0 +1,162 @@
+#ifndef CONSOLEHOST_H
+#define CONSOLEHOST_H
+
+#include <GameManager.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConsoleHost
+ * @brief Drives any number of console games on one thread with poll(2).
+ *
+ * Every game reads from one file descriptor and writes to another, a terminal
+ * or a pipe, which may be the same descriptor. The host waits for input on all
+ * of them at once, hands what arrives to GameManager::consume() and writes the
+ * output once the descriptor is writable, so a player who is thinking holds
+ * no thread. A player who takes longer than the turn timeout gets
+ * GameManager::timeOut().
+ *
+ * Descriptors are used as they are, blocking or not: the host only reads after
+ * poll() reported input and writes at most PIPE_BUF bytes at a time after it
+ * reported room for them. It never closes them. A game whose input ends or
+ * whose output fails is finished; a process that must survive a closed pipe
+ * ignores SIGPIPE.
+ *
+ * Windows has no poll() for console handles and pipes. There the games are
+ * played one after another with blocking reads, and turns are not timed.
+ */
+class ConsoleHost
+{
+public:
+	/**
+	 * @brief Constructs a host without games.
+	 *
+	 * @param turnTimeout The time a player has for every answer, 0 for no limit.
+	 */
+	explicit ConsoleHost(std::chrono::milliseconds turnTimeout = std::chrono::milliseconds::zero());
+
+	/**
+	 * @brief Adds a game, started by the next run().
+	 *
+	 * @param inputFd The descriptor the player's input is read from.
+	 * @param outputFd The descriptor the game is written to.
+	 * @return The game, to be configured before run(). It lives until it finishes.
+	 */
+	GameManager& add(int inputFd, int outputFd);
+
+	/**
+	 * @brief Plays every game until it finishes and its output is written.
+	 *
+	 * @throws std::system_error if poll() fails.
+	 */
+	void run();
+
+	/**
+	 * @return The number of games not finished yet.
+	 */
+	[[nodiscard]] std::size_t size() const { return sessions.size(); }
+
+	/**
+	 * @brief The most input read from a descriptor at a time.
+	 */
+	static constexpr std::size_t READ_SIZE = 4096;
+
+private:
+	/**
+	 * @brief A game and the state of its descriptors.
+	 */
+	struct Session
+	{
+		Session(int inputFd, int outputFd);
+
+		/**
+		 * @brief The descriptor input is read from.
+		 */
+		int inputFd;
+
+		/**
+		 * @brief The descriptor output is written to.
+		 */
+		int outputFd;
+
+		/**
+		 * @brief Collects the game's output until it is moved to `pending`.
+		 */
+		std::ostringstream output;
+
+		/**
+		 * @brief The game, writing to `output`.
+		 */
+		GameManager game;
+
+		/**
+		 * @brief Input not consumed by the game yet, the start of a word.
+		 */
+		std::string input;
+
+		/**
+		 * @brief Output not written yet.
+		 */
+		std::string pending;
+
+		/**
+		 * @brief When the current turn times out.
+		 */
+		std::chrono::steady_clock::time_point deadline;
+
+		/**
+		 * @brief Whether begin() was called.
+		 */
+		bool started{false};
+
+		/**
+		 * @brief Whether input may still arrive.
+		 */
+		bool inputOpen{true};
+	};
+
+	/**
+	 * @brief Reads the available input of a session and lets its game consume it.
+	 *
+	 * @param session The session.
+	 */
+	void readInput(Session& session) const;
+
+	/**
+	 * @brief Writes as much pending output as the descriptor takes without waiting.
+	 *
+	 * @param session The session.
+	 */
+	static void writeOutput(Session& session);
+
+	/**
+	 * @brief Moves what the game wrote to the pending output.
+	 *
+	 * @param session The session.
+	 */
+	static void collectOutput(Session& session);
+
+	/**
+	 * @brief Ends the game of a session whose player has gone.
+	 *
+	 * @param session The session.
+	 */
+	static void closeInput(Session& session);
+
+	/**
+	 * @brief The time a player has for every answer, 0 for no limit.
+	 */
+	std::chrono::milliseconds turnTimeout;
+
+	/**
+	 * @brief The games not finished yet.
+	 */
+	std::vector<std::unique_ptr<Session>> sessions;
+};
+
+#endif
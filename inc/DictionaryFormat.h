@@ -0,0 +1,78 @@
+#ifndef DICTIONARYFORMAT_H
+#define DICTIONARYFORMAT_H
+
+#include <cstdint>
+
+/**
+ * @brief Layout of the compiled (binary) dictionary format.
+ *
+ * A compiled dictionary is written by hangman_dictc and memory-mapped by
+ * WordIndex::load. All integers use the byte order of the machine that wrote
+ * the file; a file from a machine with the other byte order fails the version
+ * check. The file consists of, in order:
+ *
+ * 1. A Header.
+ * 2. `maxWordLength + 2` uint64 length offsets: the words of length n are the
+ *    word numbers [offsets[n], offsets[n + 1]).
+ * 3. `wordCount` uint32 letter masks, one per word (see LetterMask.h).
+ * 4. Only in WEIGHTED_VERSION files: `wordCount` uint32 selection weights, one per word.
+ * 5. The string pool of `poolSize` bytes. Words are stored back to back without
+ *    separators, grouped by length, so the bucket for length n is a dense array
+ *    of n-byte records.
+ *
+ * The offsets start on an 8 byte boundary, the masks and weights on a 4 byte
+ * boundary and the string pool needs no alignment. Dictionaries without
+ * weights are written as VERSION files, so they stay readable by older builds.
+ */
+namespace DictionaryFormat
+{
+	/**
+	 * @brief Identifies a compiled dictionary file.
+	 */
+	constexpr char MAGIC[8] = {'H', 'G', 'M', 'D', 'I', 'C', 'T', '\0'};
+
+	/**
+	 * @brief The format version of a dictionary without weights.
+	 */
+	constexpr std::uint32_t VERSION = 1;
+
+	/**
+	 * @brief The format version of a dictionary with weights, VERSION plus the weights section.
+	 */
+	constexpr std::uint32_t WEIGHTED_VERSION = 2;
+
+	/**
+	 * @brief The fixed-size header at the start of a compiled dictionary.
+	 */
+	struct Header
+	{
+		/**
+		 * @brief Always MAGIC.
+		 */
+		char magic[8];
+
+		/**
+		 * @brief VERSION or WEIGHTED_VERSION.
+		 */
+		std::uint32_t version;
+
+		/**
+		 * @brief The length of the longest word.
+		 */
+		std::uint32_t maxWordLength;
+
+		/**
+		 * @brief The number of words in the dictionary.
+		 */
+		std::uint64_t wordCount;
+
+		/**
+		 * @brief The size of the string pool in bytes.
+		 */
+		std::uint64_t poolSize;
+	};
+
+	static_assert(sizeof(Header) == 32, "the header layout is part of the file format");
+}
+
+#endif
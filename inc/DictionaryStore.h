@@ -0,0 +1,163 @@
+#ifndef DICTIONARYSTORE_H
+#define DICTIONARYSTORE_H
+
+#include <WordIndex.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class DictionaryStore
+ * @brief Publishes the current snapshot of a dictionary and replaces it on reload.
+ *
+ * Readers take a snapshot, a shared pointer to an immutable WordIndex, with a
+ * single atomic load and keep using it for as long as they hold it. A reload
+ * builds the new index off to the side and publishes it with an atomic store,
+ * so readers never wait for it; the old index is freed once the last game
+ * holding it is done. The file can be watched with inotify to reload it
+ * whenever it is replaced or rewritten.
+ *
+ * The store of an embedded dictionary has no file and never changes.
+ */
+class DictionaryStore
+{
+public:
+	/**
+	 * @brief Loads a dictionary file.
+	 *
+	 * @param fileToRead The word list. If a compiled sibling with the extension
+	 *                   COMPILED_DICTIONARY_EXTENSION is at least as new, it is loaded instead.
+	 * @throws FileNotFoundException if the file cannot be opened.
+	 * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+	 */
+	explicit DictionaryStore(std::filesystem::path fileToRead);
+
+	/**
+	 * @brief Wraps an index that is not backed by a file, such as the embedded dictionary.
+	 *
+	 * @param index The index, published forever.
+	 */
+	explicit DictionaryStore(std::shared_ptr<const WordIndex> index);
+
+	/**
+	 * @brief Stops watching the file.
+	 */
+	~DictionaryStore();
+
+	/**
+	 * @brief Deleted copy constructor, the store owns its watcher thread.
+	 */
+	DictionaryStore(const DictionaryStore& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the store owns its watcher thread.
+	 */
+	DictionaryStore& operator=(const DictionaryStore& other) = delete;
+
+	/**
+	 * @brief Retrieves the current index. Safe to call from any thread, never blocks.
+	 *
+	 * @return The current snapshot.
+	 */
+	[[nodiscard]] std::shared_ptr<const WordIndex> snapshot() const;
+
+	/**
+	 * @brief Loads the file again and publishes the new index.
+	 *
+	 * Runs on the calling thread; readers keep the previous snapshot until it is
+	 * published. Concurrent reloads are serialized. If loading fails the current
+	 * snapshot stays published.
+	 *
+	 * @throws FileNotFoundException if the file cannot be opened.
+	 * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+	 */
+	void reload();
+
+	/**
+	 * @brief Reloads whenever the file or its compiled sibling is written or replaced.
+	 *
+	 * A background thread waits for inotify events on the file's directory and
+	 * reloads once the directory has been quiet for WATCH_SETTLE_TIME_MS, so a
+	 * file written in several steps is loaded once. Reload errors are reported on
+	 * std::cerr and the current snapshot is kept. Does nothing for a store without
+	 * a file or when already watching.
+	 *
+	 * @throws std::system_error if the watch cannot be set up.
+	 */
+	void watch();
+
+	/**
+	 * @brief Stops the watcher thread, if any.
+	 */
+	void stopWatching();
+
+	/**
+	 * @return The number of snapshots published, 1 after construction.
+	 */
+	[[nodiscard]] std::uint64_t generation() const { return published.load(std::memory_order_acquire); }
+
+	/**
+	 * @return The dictionary file, empty for a store without a file.
+	 */
+	[[nodiscard]] const std::filesystem::path& path() const { return file; }
+
+	/**
+	 * @brief Picks the file to load for a dictionary, preferring an up to date compiled sibling.
+	 *
+	 * @param fileToRead The requested dictionary file.
+	 * @return The file that should be loaded.
+	 */
+	[[nodiscard]] static std::filesystem::path resolve(const std::filesystem::path& fileToRead);
+
+	/**
+	 * @brief How long the directory must be quiet after a change before the watcher reloads.
+	 */
+	static constexpr int WATCH_SETTLE_TIME_MS = 200;
+
+private:
+	/**
+	 * @brief Waits for changes to the file and reloads, until stopWatching().
+	 */
+	void watchLoop();
+
+	/**
+	 * @brief The dictionary file, empty for a store without a file.
+	 */
+	std::filesystem::path file;
+
+	/**
+	 * @brief The current snapshot, only accessed with std::atomic_load and std::atomic_store.
+	 */
+	std::shared_ptr<const WordIndex> current;
+
+	/**
+	 * @brief Counts the published snapshots.
+	 */
+	std::atomic<std::uint64_t> published{0};
+
+	/**
+	 * @brief Serializes reloads.
+	 */
+	std::mutex reloadMutex;
+
+	/**
+	 * @brief The inotify instance of the watcher, -1 when not watching.
+	 */
+	int inotifyFd{-1};
+
+	/**
+	 * @brief Wakes the watcher thread to stop it, -1 when not watching.
+	 */
+	int stopFd{-1};
+
+	/**
+	 * @brief The watcher thread.
+	 */
+	std::thread watcher;
+};
+
+#endif
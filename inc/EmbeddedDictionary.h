@@ -0,0 +1,55 @@
+#ifndef EMBEDDEDDICTIONARY_H
+#define EMBEDDEDDICTIONARY_H
+
+#include <LetterMask.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @struct EmbeddedDictionary
+ * @brief A dictionary compiled into the program as constant tables.
+ *
+ * The tables follow the same layout as the sections of a compiled dictionary
+ * (see DictionaryFormat.h): words are grouped by length and stored back to back
+ * in a single pool, so no file has to be read to serve them.
+ */
+struct EmbeddedDictionary
+{
+	/**
+	 * @brief The string pool, with the words of length n forming a dense array of n-byte records.
+	 */
+	std::string_view pool;
+
+	/**
+	 * @brief Bucket boundaries: the words of length n are the word numbers [lengthOffsets[n], lengthOffsets[n + 1]).
+	 */
+	const std::uint64_t* lengthOffsets;
+
+	/**
+	 * @brief The number of entries in lengthOffsets, the maximum word length plus two.
+	 */
+	std::size_t lengthOffsetCount;
+
+	/**
+	 * @brief The letter mask of every word, in word number order.
+	 */
+	const LetterMask* masks;
+
+	/**
+	 * @brief The selection weight of every word, in word number order, or nullptr if the words are unweighted.
+	 */
+	const std::uint32_t* weights;
+};
+
+#ifdef HANGMAN_EMBED_DICTIONARY
+/**
+ * @brief The dictionary generated from data/dictionary.txt at build time.
+ *
+ * Only available when the project is configured with HANGMAN_EMBED_DICTIONARY=ON.
+ */
+extern const EmbeddedDictionary EMBEDDED_DICTIONARY;
+#endif
+
+#endif
@@ -1,11 +1,16 @@
 #ifndef FILEMANAGER_H
 #define FILEMANAGER_H
 
+#include <DictionaryStore.h>
+#include <RandomEngine.h>
 #include <types.h>
+#include <WordIndex.h>
 
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -15,7 +20,11 @@ namespace fs = std::filesystem;
  * @brief Manages operations related to word lists based on difficulty levels.
  *
  * This class is responsible for retrieving word lists from a file
- * based on specified difficulty levels.
+ * based on specified difficulty levels. Each dictionary file is parsed only
+ * once per process into a WordIndex held by a DictionaryStore; later requests,
+ * for any difficulty, are served as views into the store's current snapshot.
+ * Reloading a store, or letting it watch its file, makes later requests see
+ * the new words while views already handed out keep the old ones.
  */
 class FileManager {
 
@@ -23,30 +32,101 @@ public:
 	/**
 	 * Retrieves a list of words from a file filtered by the specified difficulty level.
 	 *
-	 * @param difficulty The difficulty level of the words to retrieve. It determines the length of words
-	 *                   that should be included in the returned list.
-	 * @param fileToRead Path to the file containing the word list.
-	 * @return A vector containing words that match the specified difficulty level.
+	 * @param difficulty The difficulty level of the words to retrieve. It selects a tier of
+	 *                   the words ranked by difficulty score, see WordIndex::forDifficulty().
+	 * @param fileToRead Path to the file containing the word list. When empty, the default
+	 *                   dictionary is used: the embedded one if the library was built with
+	 *                   HANGMAN_EMBED_DICTIONARY, otherwise the file named by `filename`.
+	 * @return A view over the words that match the specified difficulty level.
 	 * @throws FileNotFoundException if the specified file cannot be opened.
 	 */
-	[[nodiscard]] std::vector<std::string>  getWordList(WordDifficultyTypes difficulty, const std::filesystem::path& fileToRead=fs::current_path()/".."/"data" /"dictionary.txt") const;
+	[[nodiscard]] WordListView getWordList(WordDifficultyTypes difficulty, const std::filesystem::path& fileToRead={}) const;
 
+	/**
+	 * Retrieves a list of words from a file whose length lies in [minLength, maxLength].
+	 *
+	 * @param minLength The minimum word length, inclusive.
+	 * @param maxLength The maximum word length, inclusive.
+	 * @param fileToRead Path to the file containing the word list. When empty, the default
+	 *                   dictionary is used: the embedded one if the library was built with
+	 *                   HANGMAN_EMBED_DICTIONARY, otherwise the file named by `filename`.
+	 * @return A view over the words within the length range.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 */
+	[[nodiscard]] WordListView getWordList(std::size_t minLength, std::size_t maxLength, const std::filesystem::path& fileToRead={}) const;
+
+	/**
+	 * Retrieves the length-bucketed index of a dictionary file, loading it on first use.
+	 *
+	 * If a compiled dictionary with the same name and the COMPILED_DICTIONARY_EXTENSION
+	 * extension exists next to the file and is not older than it, the compiled
+	 * dictionary is mapped instead of parsing the text.
+	 *
+	 * @param fileToRead Path to the file containing the word list. When empty, the default
+	 *                   dictionary is used: the embedded one if the library was built with
+	 *                   HANGMAN_EMBED_DICTIONARY, otherwise the file named by `filename`.
+	 * @return The shared index for the file.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+	 */
+	[[nodiscard]] std::shared_ptr<const WordIndex> getIndex(const std::filesystem::path& fileToRead={}) const;
 
-private:
 	/**
-	 * A map that associates words with their corresponding counts.
+	 * Retrieves the store that publishes the index of a dictionary file, loading it on first use.
 	 *
-	 * This data structure is used to store unique words as keys and
-	 * their frequency of occurrence as values. It allows for efficient
-	 * retrieval, insertion, and removal of words and their associated
-	 * counts.
+	 * @param fileToRead Path to the file containing the word list. When empty, the default
+	 *                   dictionary is used: the embedded one if the library was built with
+	 *                   HANGMAN_EMBED_DICTIONARY, otherwise the file named by `filename`.
+	 * @return The shared store for the file.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+	 */
+	[[nodiscard]] std::shared_ptr<DictionaryStore> getStore(const std::filesystem::path& fileToRead={}) const;
+
+	/**
+	 * Picks random words of a difficulty level in a single streaming pass over a text word list.
+	 *
+	 * Unlike getWordList(), the file is neither indexed nor cached: it is read in
+	 * STREAM_BUFFER_SIZE chunks and only the sampled words are kept, so dictionaries
+	 * larger than the available memory can be used. Every set of `count` matching
+	 * words is equally likely to be picked. Since words are not scored here, the
+	 * difficulty level selects words by length (see WordIndex::lengthRange()).
 	 *
-	 * Key:
-	 *    The word represented as a string.
-	 * Value:
-	 *    The count of occurrences represented as an integer.
+	 * @param difficulty The difficulty level of the words to pick.
+	 * @param count The number of words to pick, e.g. one per game of a batch.
+	 * @param random The random engine that picks the words.
+	 * @param fileToRead Path to the text word list. When empty, the default dictionary is
+	 *                   used: the embedded one if the library was built with
+	 *                   HANGMAN_EMBED_DICTIONARY, otherwise the file named by `filename`.
+	 * @return The picked words in random order, fewer than `count` if the file has fewer matching words.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
 	 */
-	std::map<std::string, int> wordList;
+	[[nodiscard]] std::vector<std::string> sampleWords(WordDifficultyTypes difficulty, std::size_t count,
+	                                                   RandomEngine& random,
+	                                                   const std::filesystem::path& fileToRead={}) const;
+
+	/**
+	 * Picks random words whose length lies in [minLength, maxLength] in a single streaming pass.
+	 *
+	 * @param minLength The minimum word length, inclusive.
+	 * @param maxLength The maximum word length, inclusive.
+	 * @param count The number of words to pick.
+	 * @param random The random engine that picks the words.
+	 * @param fileToRead Path to the text word list, empty for the default dictionary.
+	 * @return The picked words in random order, fewer than `count` if the file has fewer matching words.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 */
+	[[nodiscard]] std::vector<std::string> sampleWords(std::size_t minLength, std::size_t maxLength,
+	                                                   std::size_t count, RandomEngine& random,
+	                                                   const std::filesystem::path& fileToRead={}) const;
+
+	/**
+	 * @brief The size of the chunks sampleWords() reads, which bounds its memory use apart from the sample.
+	 */
+	static constexpr std::size_t STREAM_BUFFER_SIZE = 1 << 20;
+
+
+private:
 	/**
 	 * @brief Represents the current difficulty level of a word.
 	 *
@@ -70,10 +150,24 @@ private:
 	 *
 	 * This variable uses the filesystem library to dynamically construct the path,
 	 * pointing to a file named "dictionary.txt" located in the "data" directory,
-	 * which is one level above the current working directory.
+	 * which is one level above the current working directory. It is the default
+	 * dictionary unless one was embedded at build time.
 	 */
 	std::filesystem::path filename = fs::current_path() / ".." /"data"/"dictionary.txt";
 
+	/**
+	 * @brief Process-wide cache of loaded dictionaries, keyed by their normalized path.
+	 *
+	 * Shared by every FileManager instance so that restarting a game, switching
+	 * difficulty or running several games never parses the same file twice.
+	 */
+	static std::map<std::filesystem::path, std::shared_ptr<DictionaryStore>> indexCache;
+
+	/**
+	 * @brief Guards indexCache.
+	 */
+	static std::mutex indexCacheMutex;
+
 };
 
 #endif
@@ -0,0 +1,83 @@
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include <GameEngine.h>
+#include <LetterMask.h>
+#include <types.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+/**
+ * @class FrameRenderer
+ * @brief Composes the console view of a game into one reusable buffer.
+ *
+ * A frame is the gallows, the attempts left, the word and the guessed letters,
+ * ready to be written with a single call. The gallows come from a table of
+ * pre-rendered frames, and the word line is patched as letters are revealed
+ * instead of being rebuilt for every frame. The buffer keeps its capacity
+ * between frames, so rendering does not allocate once the first frame is drawn.
+ */
+class FrameRenderer
+{
+public:
+	/**
+	 * @brief Renders the current state of a game.
+	 *
+	 * @param game The game to render.
+	 * @return The frame, valid until the next call.
+	 */
+	[[nodiscard]] std::string_view render(const GameEngine& game);
+
+	/**
+	 * @brief The gallows after 0 to MAX_NUMBER_TRIES attempts were lost.
+	 */
+	static constexpr std::array<std::string_view, MAX_NUMBER_TRIES + 1> GALLOWS_FRAMES{
+		"  ----\n  |  |\n     |\n     |\n     |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n     |\n     |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n  |  |\n     |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n /|  |\n     |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n /|\\ |\n     |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n /|\\ |\n /   |\n     |\n=========\n",
+		"  ----\n  |  |\n  O  |\n /|\\ |\n / \\ |\n     |\n=========\n",
+	};
+
+private:
+	/**
+	 * @brief Brings the word line up to date with the game.
+	 *
+	 * @param game The game to render.
+	 */
+	void updateWordLine(const GameEngine& game);
+
+	/**
+	 * @brief Appends the letters of a mask in alphabetical order, each followed by a space.
+	 *
+	 * @param letters The set of letters.
+	 * @param out Receives the letters.
+	 */
+	static void appendLetters(LetterMask letters, std::string& out);
+
+	/**
+	 * @brief The frame being composed, reused between frames.
+	 */
+	std::string frame;
+
+	/**
+	 * @brief The word as two-character cells, the letter or '_' followed by a space.
+	 */
+	std::string wordLine;
+
+	/**
+	 * @brief The word the word line was built for.
+	 */
+	std::string renderedWord;
+
+	/**
+	 * @brief The guessed letters the word line shows.
+	 */
+	LetterMask renderedLetters{0};
+};
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include <Journal.h>
+#include <LetterMask.h>
+#include <RandomEngine.h>
+#include <WordIndex.h>
+#include <types.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @class GameEngine
+ * @brief The rules of Hangman as a headless state machine.
+ *
+ * The engine picks words, applies guesses and reports the state of a single
+ * game at a time. It performs no I/O and never terminates the process, so it
+ * can be driven by the console front end, by simulations at machine speed, or
+ * hosted inside a service. The dictionary is handed in by the caller; the engine
+ * keeps a reference to it so the words stay valid for as long as it is used.
+ */
+class GameEngine
+{
+public:
+	/**
+	 * @brief Constructs an engine without a dictionary, seeded from std::random_device.
+	 *
+	 * Games can still be started with an explicit word.
+	 */
+	GameEngine() = default;
+
+	/**
+	 * @brief Constructs an engine that picks words from the given dictionary.
+	 *
+	 * @param dictionary The dictionary to pick words from.
+	 */
+	explicit GameEngine(std::shared_ptr<const WordIndex> dictionary);
+
+	/**
+	 * @brief Replaces the dictionary that later games pick words from.
+	 *
+	 * The current game, if any, is not affected.
+	 *
+	 * @param dictionary The dictionary to pick words from.
+	 */
+	void setDictionary(std::shared_ptr<const WordIndex> dictionary);
+
+	/**
+	 * @return The dictionary later games pick words from, may be null.
+	 */
+	[[nodiscard]] const std::shared_ptr<const WordIndex>& getDictionary() const { return dictionary; }
+
+	/**
+	 * @brief Seeds the random engine used to pick words.
+	 *
+	 * @param seed The seed. The same seed, dictionary and difficulties yield the same words.
+	 */
+	void setSeed(std::uint64_t seed);
+
+	/**
+	 * @brief Records every game of this engine in a journal from the next game on.
+	 *
+	 * A game is recorded when it is won or lost, or as abandoned when another
+	 * game starts first. A game still in progress when the journal is replaced
+	 * is recorded as abandoned; one still in progress when the engine is
+	 * destroyed is not recorded.
+	 *
+	 * @param journal The journal, or nullptr to stop recording.
+	 */
+	void setJournal(std::shared_ptr<Journal> journal);
+
+	/**
+	 * @brief Seeds the engine and starts a new game with a word of the given difficulty.
+	 *
+	 * @param seed The seed for the word selection.
+	 * @param difficulty The difficulty of the word.
+	 * @return True if a game was started, false if the dictionary has no word of that difficulty.
+	 */
+	bool newGame(std::uint64_t seed, WordDifficultyTypes difficulty);
+
+	/**
+	 * @brief Starts a new game with a word of the given difficulty, continuing the random sequence.
+	 *
+	 * @param difficulty The difficulty of the word.
+	 * @return True if a game was started, false if the dictionary has no word of that difficulty.
+	 */
+	bool newGame(WordDifficultyTypes difficulty);
+
+	/**
+	 * @brief Starts a new game with a word picked from a list, in proportion to the word weights.
+	 *
+	 * @param words The words to pick from.
+	 * @param difficulty The difficulty the list was taken for, recorded in the journal.
+	 * @return True if a game was started, false if the list is empty.
+	 */
+	bool newGame(const WordListView& words, std::optional<WordDifficultyTypes> difficulty = std::nullopt);
+
+	/**
+	 * @brief Starts a new game with the given word.
+	 *
+	 * @param word The word to guess.
+	 */
+	void newGameWithWord(std::string_view word);
+
+	/**
+	 * @brief Applies a guessed letter to the current game.
+	 *
+	 * Letters are case-insensitive. Only CORRECT and INCORRECT change the state.
+	 *
+	 * @param letter The guessed letter.
+	 * @return The outcome of the guess.
+	 */
+	GuessResult guess(char letter);
+
+	/**
+	 * @brief Ends the current turn without a guess, because its time ran out.
+	 *
+	 * Costs an attempt like an incorrect letter, without adding to the incorrect letters.
+	 *
+	 * @return TIMED_OUT, or GAME_OVER if no game is in progress.
+	 */
+	GuessResult timeOut();
+
+	/**
+	 * @brief Retrieves the target word with every letter not yet guessed replaced by '_'.
+	 *
+	 * The masked word is kept up to date as letters are revealed, so this is free.
+	 *
+	 * @return The masked word, one character per character of the target word.
+	 */
+	[[nodiscard]] const std::string& maskedWord() const { return masked; }
+
+	/**
+	 * @return The word being guessed, empty before the first game.
+	 */
+	[[nodiscard]] const std::string& targetWord() const { return target; }
+
+	/**
+	 * @return The number of incorrect guesses the player can still make.
+	 */
+	[[nodiscard]] int attemptsLeft() const { return attempts; }
+
+	/**
+	 * @return The letters guessed so far, correct or not.
+	 */
+	[[nodiscard]] LetterMask guessedLetters() const { return guessed; }
+
+	/**
+	 * @return The letters guessed so far that are not in the word.
+	 */
+	[[nodiscard]] LetterMask incorrectLetters() const { return incorrect; }
+
+	/**
+	 * @return The state of the current game.
+	 */
+	[[nodiscard]] GameStatus status() const { return state; }
+
+	/**
+	 * @return True if every letter of the word has been guessed.
+	 */
+	[[nodiscard]] bool won() const { return state == GameStatus::WON; }
+
+	/**
+	 * @return True if the attempts ran out before the word was guessed.
+	 */
+	[[nodiscard]] bool lost() const { return state == GameStatus::LOST; }
+
+	/**
+	 * @return True if the current game has been won or lost.
+	 */
+	[[nodiscard]] bool over() const { return won() || lost(); }
+
+private:
+	/**
+	 * @brief Resets the guess state for a new target word.
+	 *
+	 * @param word The word to guess.
+	 * @param letters The distinct letters of the word.
+	 */
+	void reset(std::string_view word, LetterMask letters);
+
+	/**
+	 * @brief Takes an attempt away and ends the game as lost when none is left.
+	 */
+	void loseAttempt();
+
+	/**
+	 * @brief Starts recording the game just reset, and finishes the record at once if it is already won.
+	 *
+	 * @param fingerprint The fingerprint of the word's dictionary, 0 for none.
+	 * @param difficulty The difficulty of the word, if it was picked by difficulty.
+	 * @param wordNumber The number of the word in its dictionary, if it was picked from one.
+	 */
+	void startRecord(std::uint32_t fingerprint, std::optional<WordDifficultyTypes> difficulty,
+	                 std::optional<std::uint32_t> wordNumber);
+
+	/**
+	 * @brief The dictionary words are picked from, may be null.
+	 */
+	std::shared_ptr<const WordIndex> dictionary;
+
+	/**
+	 * @brief The random engine used to pick words.
+	 */
+	RandomEngine random;
+
+	/**
+	 * @brief The seed last given to `random`, 0 if it was seeded from std::random_device.
+	 */
+	std::uint64_t seed{0};
+
+	/**
+	 * @brief Receives the records of finished games, may be null.
+	 */
+	std::shared_ptr<Journal> journal;
+
+	/**
+	 * @brief The events of the game in progress, active while it is recorded.
+	 */
+	GameRecord record;
+
+	/**
+	 * @brief The word being guessed.
+	 */
+	std::string target;
+
+	/**
+	 * @brief The target word with the letters not yet guessed replaced by '_'.
+	 */
+	std::string masked;
+
+	/**
+	 * @brief The distinct letters of the target word.
+	 */
+	LetterMask targetLetters{0};
+
+	/**
+	 * @brief The letters guessed so far, correct or not.
+	 */
+	LetterMask guessed{0};
+
+	/**
+	 * @brief The letters guessed so far that are not in the word.
+	 */
+	LetterMask incorrect{0};
+
+	/**
+	 * @brief The number of incorrect guesses the player can still make.
+	 */
+	int attempts{MAX_NUMBER_TRIES};
+
+	/**
+	 * @brief The state of the current game.
+	 */
+	GameStatus state{GameStatus::NOT_STARTED};
+};
+
+#endif
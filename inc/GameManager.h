@@ -2,25 +2,42 @@
 #define GAMEMANAGER_H
 
 #include <FileManager.h>
+#include <FrameRenderer.h>
+#include <GameEngine.h>
+#include <LetterMask.h>
 #include <Player.h>
+#include <PlayerStore.h>
 #include <types.h>
 
-#include <set>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 
 
 /**
  * @class GameManager
- * @brief Manages the core game logic and state for the Hangman game.
+ * @brief The console front end of the Hangman game.
+ *
+ * The turn loop is a state machine driven by the caller: consume() takes
+ * whatever input has arrived and returns as soon as it needs more, and
+ * timeOut() ends a turn the player took too long for. Nothing blocks, so one
+ * thread can drive many sessions (see ConsoleHost). Output is written to the
+ * stream given to the constructor. The rules and game state live in a
+ * GameEngine, which this class drives.
  */
 class GameManager
 {
 
 public:
 	/**
-	* @brief Default constructor for the GameManager class.
-	*/
-	GameManager() = default;
+	 * @brief Constructs a game writing to a stream.
+	 *
+	 * @param output Receives everything shown to the player, it must outlive the game.
+	 */
+	explicit GameManager(std::ostream& output = std::cout);
 
 	/**
 	 * @brief Deleted copy constructor to prevent copying of the GameManager instance.
@@ -53,43 +70,41 @@ public:
 	 * This method displays the current hangman figure, the target word with unguessed
 	 * letters masked, the list of incorrect guessed letters, and the list of all guessed letters.
 	 *
-	 * It calls helper methods to display the hangman figure and the correctly guessed portions of the target word.
+	 * The whole frame is composed by a FrameRenderer and written to the console with a single call.
 	 */
 	void draw() const;
 
 	/**
-	 * @brief Starts a new game session of Hangman.
-	 *
-	 * This method initializes the game by requesting the player's name
-	 * and setting up the Player instance. It also prints a welcome message
-	 * and sets up the game environment for the player to begin playing Hangman.
+	 * @brief Welcomes the player and asks for the name, or for the difficulty if the name is already set.
 	 */
-	void start();
+	void begin();
 
 	/**
-	 * Displays a menu prompting the player to guess a letter.
+	 * @brief Plays the turns the input is enough for.
+	 *
+	 * Input is split into whitespace separated words. The name and the
+	 * difficulty are one word each, a guess and the answer to "play again?" one
+	 * character each, so "abc" guesses three letters. A word still being typed
+	 * at the end of the input is left for the next call.
 	 *
-	 * This method is responsible for:
-	 * 1. Prompting the player to enter a letter.
-	 * 2. Capturing the entered letter.
-	 * 3. Converting the letter to lowercase.
-	 * 4. Invoking the guessLetter method to process the guessed letter.
+	 * @param input The input that has arrived and was not consumed before.
+	 * @param endOfInput True if no more input will follow, the game finishes once the input is used.
+	 * @return The number of bytes consumed, the caller keeps the rest for the next call.
 	 */
-	void menu();
+	std::size_t consume(std::string_view input, bool endOfInput = false);
 
 	/**
-	 * @brief Prompts the user to decide if they want to play again.
+	 * @brief Ends the turn the player took too long for.
 	 *
-	 * This method asks the user if they would like to play another game.
-	 * If the user indicates 'y', the method starts a new game by calling newGame().
-	 * If the user indicates 'n', the application will exit.
-	 *
-	 * No parameters are required to call this method.
-	 *
-	 * This method reads input directly from the standard input (e.g., via std::cin)
-	 * and thus is blocking; it waits for user input before proceeding.
+	 * A guess that runs out of time costs an attempt, see GameEngine::timeOut().
+	 * At any other prompt an idle player is said goodbye to and the game finishes.
+	 */
+	void timeOut();
+
+	/**
+	 * @return What the game is waiting for.
 	 */
-	void playAgain();
+	[[nodiscard]] TurnState turnState() const { return turn; }
 
 	/**
 	 * Retrieves the number of attempts left in the game.
@@ -101,9 +116,9 @@ public:
 	/**
 	 * @brief Initializes a new game by resetting game state.
 	 *
-	 * This method clears the guessed letters and incorrect guessed letters,
-	 * resets the number of attempts left to the maximum number of tries, and
-	 * selects a new target word from the word list.
+	 * This method selects a new target word from the word list, which makes the
+	 * engine clear the guessed letters and incorrect guessed letters and reset the
+	 * number of attempts left to the maximum number of tries.
 	 */
 	void newGame();
 
@@ -118,7 +133,7 @@ public:
 	 *
 	 * This method determines if the player has successfully guessed all the letters in the target word.
 	 * Winning conditions are met if all the letters in the target word have been guessed correctly
-	 * and there are still attempts left.
+	 * before the attempts ran out.
 	 *
 	 * @return true if the player has won the game, false otherwise.
 	 */
@@ -137,7 +152,46 @@ public:
 	 */
 	std::string getTargetWord();
 
+	/**
+	 * @brief Seeds the random engine used to pick words.
+	 *
+	 * Games started after seeding pick the same sequence of words for the same
+	 * seed, difficulty and dictionary, which makes simulations and replays
+	 * deterministic. Without a call to this method the engine is seeded once
+	 * from std::random_device.
+	 *
+	 * @param seed The seed for the word selection.
+	 */
+	void setSeed(std::uint64_t seed);
+
+	/**
+	 * @brief Keeps the player's profile in a store across sessions.
+	 *
+	 * The first game loads the level and score of a returning player and every
+	 * finished game is recorded. Without a store they last for the session only.
+	 *
+	 * @param store The store, or nullptr to keep nothing.
+	 */
+	void setPlayerStore(std::shared_ptr<PlayerStore> store);
+
+	/**
+	 * @brief Records every game from the next one on in a journal, see GameEngine::setJournal().
+	 *
+	 * @param journal The journal, or nullptr to stop recording.
+	 */
+	void setJournal(std::shared_ptr<Journal> journal);
+
 private:
+	/**
+	 * @brief Receives everything shown to the player.
+	 */
+	std::ostream& out;
+
+	/**
+	 * @brief What the game is waiting for.
+	 */
+	TurnState turn{TurnState::NAME};
+
 	/**
 	 * @brief Manages file operations such as reading, writing, and deleting files.
 	 *
@@ -151,33 +205,33 @@ private:
 	FileManager file_manager;
 
 	/**
-	 * @brief Represents the number of remaining attempts a user has.
+	 * @brief The headless game state machine.
 	 *
-	 * attemptsLeft is initialized to the maximum number of allowable tries,
-	 * defined by the constant MAX_NUMBER_TRIES. It is decremented each time
-	 * an attempt is made and is used to track how many more attempts are
-	 * possible before an action is no longer permitted.
+	 * Holds the target word, the guessed letters, the attempts left and whether
+	 * the game has been won or lost. Every rule of the game is applied by it.
 	 */
-	int attemptsLeft{MAX_NUMBER_TRIES};
+	GameEngine engine;
 
 	/**
-	 * A set containing the characters that have been guessed by the player.
-	 *
-	 * This set is used to keep track of all unique letters that the player
-	 * has guessed in a game. It helps in checking if a guess has already been made,
-	 * and assists in game logic to prevent duplicate guesses.
+	 * @brief Composes the frames drawn by draw(), keeping its buffers between turns.
 	 */
-	std::set<char> guessedLetters;
+	mutable FrameRenderer renderer;
+
+	/**
+	 * @brief The difficulty chosen by the player for the current game.
+	 */
+	WordDifficultyTypes currentDifficulty{WordDifficultyTypes::EASY};
 
 	/**
 	 * @brief A list of words used in the game.
 	 *
-	 * This vector holds a collection of words that
-	 * are used throughout the game. The list is populated
-	 * based on the selected difficulty level and is utilized
-	 * to randomly select words for various game functionalities.
+	 * This view holds the collection of words that
+	 * are used throughout the game. It points into the dictionary
+	 * index cached by FileManager, is selected based on the chosen
+	 * difficulty level and is utilized to randomly select words
+	 * for various game functionalities.
 	 */
-	std::vector<std::string> wordList;
+	WordListView wordList;
 
 	/**
 	 * @brief Pointer to a Player object initialized to nullptr.
@@ -185,92 +239,81 @@ private:
 	Player *player{nullptr};
 
 	/**
-	 * @brief Represents the current level of a game or application.
+	 * @brief The player's level, score, wins and losses.
 	 *
-	 * This variable is used to keep track of which level the player or user is currently on.
-	 * The value starts at 1 and can increase as the player or user progresses.
+	 * Loaded from `players` when the first game starts and updated after every finished game.
 	 */
-	int level{1};
+	PlayerProfile profile;
 
 	/**
-	 * @brief A collection of characters representing letters that have been incorrectly guessed by the player.
-	 *
-	 * This set is used within the game to keep track of all incorrect guesses made by the player. It helps in:
-	 * - Displaying the incorrect guesses to the player.
-	 * - Determining the state of the hangman graphic.
-	 * - Checking if a guessed letter has already been guessed incorrectly.
+	 * @brief Persists `profile`, nullptr to keep it for the session only.
 	 */
-	std::set<char> incorrectGuessedLetters{};
+	std::shared_ptr<PlayerStore> players;
 
 	/**
-	 * @brief The word that players attempt to guess in the game.
-	 *
-	 * This variable stores the current word that players are trying to guess.
-	 * It is selected randomly from a predefined word list at the start of a new game.
-	 * The game logic involves players guessing letters to try to reveal the entire word.
-	 * It is used in various functions to check guesses, display the word status,
-	 * and determine if the player has won.
+	 * @var playerName
+	 * @brief Stores the name of the player.
 	 */
-	std::string targetWord{};
+	std::string playerName;
 
 	/**
-	 * @brief Represents the score in a game or application.
+	 * Retrieves the set of letters that have been guessed in the game.
 	 *
-	 * This integer value is used to keep track of points or
-	 * performance metrics. The initial value is set to 0.
+	 * @return A bitmask of the letters that have been guessed.
 	 */
-	int score{0};
+	[[nodiscard]] LetterMask getGuessedLetters() const;
 
 	/**
-	 * Generates a random integer between the specified minimum and maximum values.
+	 * Sets the difficulty level for the word.
 	 *
-	 * @param min The minimum value that can be generated.
-	 * @param max The maximum value that can be generated.
-	 * @return A random integer between min and max inclusive.
+	 * @param difficulty An enum value of type WordDifficultyTypes indicating the level of difficulty to be set for the word.
 	 */
-	static int generateRandomNumber(int min, int max);
+	void setDifficulty(WordDifficultyTypes difficulty);
 
 	/**
-	 * @brief A vector of strings.
+	 * @brief Handles one word or character of input in the current turn state.
 	 *
-	 * This variable holds a collection of words.
+	 * @param input A whole word for NAME and DIFFICULTY, a single character otherwise.
+	 */
+	void handleInput(std::string_view input);
+
+	/**
+	 * @brief Asks the player for the difficulty of the next game.
 	 */
-	std::vector<std::string> words{};
+	void promptDifficulty();
 
 	/**
-	 * @var mutable bool game_state
-	 * @brief Represents the current state of the game.
+	 * @brief Starts a game at the chosen difficulty, creating the Player on the first game.
+	 *
+	 * Loads the stored profile of a returning player. An answer other than 1 to 3 asks again.
 	 *
-	 * This variable indicates whether the game is active (true) or inactive (false).
-	 * It is mutable, allowing the state to be modified even within const member functions.
+	 * @param answer The player's answer.
 	 */
-	mutable bool game_state{false};
+	void chooseDifficulty(std::string_view answer);
 
 	/**
-	 * @var playerName
-	 * @brief Stores the name of the player.
+	 * @brief Draws the game and asks for a letter, or announces the outcome and asks to play again once the game is over.
 	 */
-	std::string playerName;
+	void nextTurn();
 
 	/**
-	 * Retrieves the set of letters that have been guessed in the game.
+	 * @brief Handles a guessed letter, or '?' for a hint.
 	 *
-	 * @return A set containing the letters that have been guessed.
+	 * @param letter The character entered by the player.
 	 */
-	std::set<char> getGuessedLetters();
+	void takeGuess(char letter);
 
 	/**
-	 * Sets the difficulty level for the word.
+	 * @brief Starts another game unless the answer is 'n'.
 	 *
-	 * @param difficulty An enum value of type WordDifficultyTypes indicating the level of difficulty to be set for the word.
+	 * @param answer The character entered by the player.
 	 */
-	void setDifficulty(WordDifficultyTypes difficulty);
+	void answerPlayAgain(char answer);
 
 	/**
-	 * Checks if the guessed letter is correct and updates the game state accordingly.
+	 * Applies the guessed letter to the game and tells the player the outcome.
 	 *
 	 * @param letter The letter guessed by the player.
-	 * @return True if the maximum number of tries has been exceeded, false otherwise.
 	 */
 	void guessLetter(char letter);
 
@@ -278,59 +321,33 @@ private:
 	/**
 	 * @brief Handles the result of a player's guess in the Hangman game.
 	 *
-	 * Updates the state based on whether the guessed letter is found in the word.
-	 * This includes updating the list of guessed letters, decrementing attempts, and
-	 * determining if the maximum number of tries has been exceeded.
+	 * Tells the player whether the guessed letter was found in the word, or why
+	 * the guess did not count.
 	 *
 	 * @param letter The letter that was guessed.
-	 * @param maxTriesExceeded A reference to a boolean that will be set to true if the maximum
-	 * number of tries has been exceeded.
-	 * @param letterFound A boolean indicating whether the guessed letter is in the word.
-	 * @param letter_ The original letter guessed by the player.
+	 * @param result The outcome reported by the engine.
 	 * @return A boolean indicating whether the player should keep guessing.
 	 */
-	bool handle_guess_result(char letter, bool& maxTriesExceeded, bool letterFound, char letter_);
+	bool handle_guess_result(char letter, GuessResult result);
 
 	/**
-	 * @brief Displays the current state of the target word with guessed and un-guessed letters.
-	 *
-	 * This method prints the target word, revealing letters that have been correctly guessed
-	 * and displaying underscores for letters that have not yet been guessed. Each character
-	 * of the word is followed by a space for readability. The method ends the line after
-	 * displaying the entire word.
+	 * @brief Adds the outcome of the finished game to the profile and stores it.
 	 */
-	void displayWord() const;
+	void recordGame();
 
 	/**
-	 * @brief Displays the current state of the hangman figure based on the number of incorrect guesses.
+	 * @brief Suggests a letter to the player.
 	 *
-	 * This function draws the hangman figure on the console. The drawing changes based on the number
-	 * of incorrect letters guessed. It also displays the number of attempts left.
+	 * Runs a Solver over the dictionary words of the target's length and prints
+	 * the letter that best splits the words still consistent with the game.
 	 */
-	void displayHangman() const;
+	void showHint() const;
 
 	/**
-	 * @brief Selects a new random word from the current word list and updates the target word.
-	 *
-	 * Ensures that the word list is not empty before selecting and setting a random word from the list to
-	 * the targetWord member variable.
+	 * @brief Selects a new random word from the current word list and starts a game with it.
 	 *
 	 * If the word list is found to be empty, it prints an error message and exits early.
 	 */
 	void getNewWord();
-
-	/**
-	 * @brief Decreases the number of attempts left by one.
-	 */
-	void decrementAttemptsLeft();
-
-	/**
-	 * @brief Retrieves the number of letters in the current target word.
-	 *
-	 * This method returns the count of characters in the `targetWord`.
-	 *
-	 * @return The number of letters in the `targetWord`.
-	 */
-	int getNumberOfLettersInWord() const;
 };
 #endif
@@ -0,0 +1,182 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <DictionaryStore.h>
+#include <Journal.h>
+#include <Leaderboard.h>
+#include <PlayerStore.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct ServerConfig
+ * @brief Describes where a GameServer listens and how many reactors it runs.
+ */
+struct ServerConfig
+{
+	/**
+	 * @brief The store of the dictionary shared by every session.
+	 */
+	std::shared_ptr<const DictionaryStore> dictionary;
+
+	/**
+	 * @brief The store of the player profiles shared by every session, nullptr to keep none.
+	 */
+	std::shared_ptr<PlayerStore> players;
+
+	/**
+	 * @brief The leaderboard shared by every session, nullptr for none.
+	 */
+	std::shared_ptr<Leaderboard> leaderboard;
+
+	/**
+	 * @brief Records the games of every session, nullptr for none.
+	 */
+	std::shared_ptr<Journal> journal;
+
+	/**
+	 * @brief The IPv4 address to listen on when no Unix socket is given.
+	 */
+	std::string host{"127.0.0.1"};
+
+	/**
+	 * @brief The TCP port, 0 for any free port.
+	 */
+	std::uint16_t port{7777};
+
+	/**
+	 * @brief Listen on this Unix domain socket instead of TCP when not empty.
+	 */
+	std::filesystem::path unixSocket;
+
+	/**
+	 * @brief The number of reactor threads, 0 for one per hardware thread.
+	 */
+	std::size_t threads{0};
+
+	/**
+	 * @brief Session i, counted over all reactors, is seeded with seed + i.
+	 */
+	std::uint64_t seed{0};
+};
+
+/**
+ * @class GameServer
+ * @brief Hosts concurrent GameSession instances over TCP or a Unix domain socket.
+ *
+ * The server runs one epoll reactor per thread. With TCP every reactor has its
+ * own listening socket bound with SO_REUSEPORT, so the kernel spreads new
+ * connections over the reactors; a Unix socket is shared and polled with
+ * EPOLLEXCLUSIVE. A connection stays on the reactor that accepted it for its
+ * whole life, so its session is only ever touched by one thread and nothing on
+ * the request path is locked. Every request that arrives in one read is
+ * answered with a single write.
+ *
+ * Linux only.
+ */
+class GameServer
+{
+public:
+	/**
+	 * @brief Opens the listening sockets.
+	 *
+	 * @param config Where to listen and what to serve.
+	 * @throws std::system_error if a socket cannot be created or bound.
+	 * @throws std::invalid_argument if the configuration has no dictionary or a bad host.
+	 */
+	explicit GameServer(ServerConfig config);
+
+	/**
+	 * @brief Stops the reactors and closes every socket.
+	 */
+	~GameServer();
+
+	/**
+	 * @brief Deleted copy constructor, the server owns its sockets and threads.
+	 */
+	GameServer(const GameServer& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the server owns its sockets and threads.
+	 */
+	GameServer& operator=(const GameServer& other) = delete;
+
+	/**
+	 * @brief Starts the reactor threads, returns immediately.
+	 */
+	void start();
+
+	/**
+	 * @brief Asks the reactors to close their connections and exit, then joins them.
+	 */
+	void stop();
+
+	/**
+	 * @return The TCP port the server listens on, 0 when it listens on a Unix socket.
+	 */
+	[[nodiscard]] std::uint16_t port() const { return boundPort; }
+
+	/**
+	 * @return The number of sessions accepted so far.
+	 */
+	[[nodiscard]] std::uint64_t sessionsAccepted() const { return nextSession.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Read buffer size of a reactor, the most a connection reads at once.
+	 */
+	static constexpr std::size_t READ_BUFFER_SIZE = 16384;
+
+	/**
+	 * @brief A connection stops being read while more than this many reply bytes are unsent.
+	 */
+	static constexpr std::size_t MAX_PENDING_OUTPUT = 65536;
+
+private:
+	class Reactor;
+
+	/**
+	 * @brief Creates a listening socket for the configured address.
+	 *
+	 * @return The socket.
+	 */
+	[[nodiscard]] int openListener();
+
+	/**
+	 * @brief What the server serves.
+	 */
+	ServerConfig config;
+
+	/**
+	 * @brief The TCP port actually bound, resolved when the configured port is 0.
+	 */
+	std::uint16_t boundPort{0};
+
+	/**
+	 * @brief Counts the sessions to give each its own seed.
+	 */
+	std::atomic<std::uint64_t> nextSession{0};
+
+	/**
+	 * @brief The listening sockets, one per reactor for TCP or a single shared one.
+	 */
+	std::vector<int> listeners;
+
+	/**
+	 * @brief The reactors, one per thread.
+	 */
+	std::vector<std::unique_ptr<Reactor>> reactors;
+
+	/**
+	 * @brief The reactor threads, empty while the server is stopped.
+	 */
+	std::vector<std::thread> threads;
+};
+
+#endif
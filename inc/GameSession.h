@@ -0,0 +1,156 @@
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include <DictionaryStore.h>
+#include <GameEngine.h>
+#include <Leaderboard.h>
+#include <PlayerStore.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class GameSession
+ * @brief One remote player's games, driven by a line-based text protocol.
+ *
+ * Every request is one line and gets exactly one reply line:
+ *
+ *     NEW [easy|medium|hard]   starts a game (medium by default)
+ *     GUESS <letter>           guesses a letter
+ *     STATE                    repeats the state of the current game
+ *     NAME <player>            plays as a player whose profile is kept
+ *     PROFILE                  reports the player's profile
+ *     TOP [count]              reports the leaderboard, 10 players by default
+ *     METRICS                  reports the server's metrics
+ *     QUIT                     ends the session
+ *
+ * A game reply is `<RESULT> <masked word> <attempts left> <STATUS>`, followed
+ * by the word once the game is over. RESULT is NEW, STATE or the name of the
+ * GuessResult, STATUS the name of the GameStatus, for example
+ * `CORRECT _a__ 6 IN_PROGRESS`. NAME and PROFILE are answered with
+ * `PLAYER <name> <level> <score> <wins> <losses>`; once a name is set every
+ * finished game is recorded in the player store and the new score submitted
+ * to the leaderboard. A game left unfinished by NEW, QUIT or a closed connection
+ * (see end()) is recorded as lost. TOP is answered with `TOP <count>` followed by the name
+ * and score of each player, best first. METRICS is answered with `METRICS` and the
+ * JSON snapshot of Metrics, QUIT with BYE and bad requests with
+ * `ERR <reason>`. Commands are case-insensitive.
+ *
+ * Every NEW takes the dictionary's current snapshot, so a reloaded dictionary
+ * is used from the next game on while a game in progress keeps its word.
+ *
+ * The session performs no I/O, the transport hands in lines and sends the replies.
+ */
+class GameSession
+{
+public:
+	/**
+	 * @brief Constructs a session picking words from a shared dictionary.
+	 *
+	 * @param dictionary The store of the dictionary, shared by every session.
+	 * @param seed The seed for the session's word selection.
+	 * @param players The store of the player profiles, nullptr to refuse NAME.
+	 * @param leaderboard The leaderboard, nullptr to refuse TOP.
+	 * @param journal Records the session's games, nullptr for none.
+	 */
+	GameSession(std::shared_ptr<const DictionaryStore> dictionary, std::uint64_t seed,
+	            std::shared_ptr<PlayerStore> players = nullptr, std::shared_ptr<Leaderboard> leaderboard = nullptr,
+	            std::shared_ptr<Journal> journal = nullptr);
+
+	/**
+	 * @brief Handles one request.
+	 *
+	 * @param line The request, without the line terminator. A trailing '\r' is ignored.
+	 * @param reply Receives the reply line, including its '\n'.
+	 */
+	void handleLine(std::string_view line, std::string& reply);
+
+	/**
+	 * @return True once the player has quit and the connection should be closed.
+	 */
+	[[nodiscard]] bool closed() const { return quit; }
+
+	/**
+	 * @brief Ends the session when its connection closes, whether or not the player sent QUIT.
+	 *
+	 * An unfinished game of a named player is recorded as lost, like on QUIT,
+	 * so dropping the connection cannot dodge a loss or keep a leaderboard score.
+	 */
+	void end();
+
+	/**
+	 * @brief The number of players TOP reports without a count.
+	 */
+	static constexpr std::size_t DEFAULT_TOP_COUNT = 10;
+
+	/**
+	 * @brief The longest request accepted, longer lines are a protocol error.
+	 */
+	static constexpr std::size_t MAX_LINE_LENGTH = 256;
+
+private:
+	/**
+	 * @brief Appends the state of the current game.
+	 *
+	 * @param result The first word of the reply.
+	 * @param reply Receives the reply line.
+	 */
+	void appendState(std::string_view result, std::string& reply) const;
+
+	/**
+	 * @brief Appends `PLAYER <name> <level> <score> <wins> <losses>`.
+	 *
+	 * @param profile The player's profile.
+	 * @param reply Receives the reply line.
+	 */
+	void appendProfile(const PlayerProfile& profile, std::string& reply) const;
+
+	/**
+	 * @brief Records a game of a named player and submits the new score to the leaderboard.
+	 *
+	 * @param won True if the game was won.
+	 * @param attemptsLeft The attempts left at the end of the game.
+	 * @param gameDifficulty The difficulty of the game.
+	 */
+	void recordGame(bool won, int attemptsLeft, WordDifficultyTypes gameDifficulty);
+
+	/**
+	 * @brief Publishes the dictionary new games pick words from.
+	 */
+	std::shared_ptr<const DictionaryStore> dictionary;
+
+	/**
+	 * @brief Keeps the profiles of named players, shared by every session.
+	 */
+	std::shared_ptr<PlayerStore> players;
+
+	/**
+	 * @brief Ranks the named players by score, shared by every session.
+	 */
+	std::shared_ptr<Leaderboard> leaderboard;
+
+	/**
+	 * @brief The game state of the session.
+	 */
+	GameEngine engine;
+
+	/**
+	 * @brief The difficulty of the current game.
+	 */
+	WordDifficultyTypes difficulty{WordDifficultyTypes::MEDIUM};
+
+	/**
+	 * @brief The player set by NAME, empty for an anonymous session.
+	 */
+	std::string playerName;
+
+	/**
+	 * @brief Whether the player has quit.
+	 */
+	bool quit{false};
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef GUESSSTRATEGY_H
+#define GUESSSTRATEGY_H
+
+#include <GameEngine.h>
+#include <RandomEngine.h>
+#include <Solver.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class GuessStrategy
+ * @brief An automated player that chooses the next letter to guess.
+ *
+ * Strategies may keep state between guesses of one game, so each thread of a
+ * simulation uses its own instance.
+ */
+class GuessStrategy
+{
+public:
+	/**
+	 * @brief Default virtual destructor.
+	 */
+	virtual ~GuessStrategy() = default;
+
+	/**
+	 * @brief Called when a new game starts, before the first guess.
+	 *
+	 * @param game The game that was just started.
+	 * @param seed A per-game seed for strategies that make random choices.
+	 */
+	virtual void newGame(const GameEngine& game, std::uint64_t seed) = 0;
+
+	/**
+	 * @brief Chooses the next letter to guess.
+	 *
+	 * @param game The game in progress.
+	 * @return A letter from 'a' to 'z' that has not been guessed yet.
+	 */
+	virtual char nextGuess(const GameEngine& game) = 0;
+};
+
+/**
+ * @class FrequencyGuessStrategy
+ * @brief Guesses letters in order of their frequency in English text.
+ */
+class FrequencyGuessStrategy final : public GuessStrategy
+{
+public:
+	void newGame(const GameEngine& game, std::uint64_t seed) override;
+	char nextGuess(const GameEngine& game) override;
+};
+
+/**
+ * @class RandomGuessStrategy
+ * @brief Guesses a uniformly random letter that has not been guessed yet.
+ */
+class RandomGuessStrategy final : public GuessStrategy
+{
+public:
+	void newGame(const GameEngine& game, std::uint64_t seed) override;
+	char nextGuess(const GameEngine& game) override;
+
+private:
+	/**
+	 * @brief Picks the letters, reseeded for every game.
+	 */
+	RandomEngine random;
+};
+
+/**
+ * @class SolverGuessStrategy
+ * @brief Guesses the letter suggested by a Solver over the game's dictionary.
+ *
+ * Falls back to English letter frequency when the game has no dictionary or the
+ * word is not in it.
+ */
+class SolverGuessStrategy final : public GuessStrategy
+{
+public:
+	void newGame(const GameEngine& game, std::uint64_t seed) override;
+	char nextGuess(const GameEngine& game) override;
+
+private:
+	/**
+	 * @brief Tracks the candidates of the current game.
+	 */
+	Solver solver;
+
+	/**
+	 * @brief Used when the solver has no suggestion.
+	 */
+	FrequencyGuessStrategy fallback;
+};
+
+/**
+ * @brief Creates a fresh strategy instance, once per simulation thread.
+ */
+using GuessStrategyFactory = std::function<std::unique_ptr<GuessStrategy>()>;
+
+/**
+ * @brief Looks up a built-in strategy by name.
+ *
+ * @param name The strategy name, one of guessStrategyNames().
+ * @return A factory for the strategy, or an empty function for an unknown name.
+ */
+[[nodiscard]] GuessStrategyFactory makeGuessStrategyFactory(const std::string& name);
+
+/**
+ * @return The names of the built-in strategies.
+ */
+[[nodiscard]] std::vector<std::string> guessStrategyNames();
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <MappedFile.h>
+#include <types.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct JournalGuess
+ * @brief One guess of a journaled game.
+ */
+struct JournalGuess
+{
+	/**
+	 * @brief The guessed character, as handed to the engine.
+	 */
+	char letter{'\0'};
+
+	/**
+	 * @brief Microseconds since the previous guess, or since the start of the game.
+	 */
+	std::uint64_t delayMicros{0};
+};
+
+/**
+ * @struct JournalGame
+ * @brief One game read back from a journal, see JournalFormat.h for the meaning of the fields.
+ */
+struct JournalGame
+{
+	/**
+	 * @brief The seed the engine was last given, 0 if it was never seeded.
+	 */
+	std::uint64_t seed{0};
+
+	/**
+	 * @brief The fingerprint of the dictionary the word was picked from, 0 for none.
+	 */
+	std::uint32_t fingerprint{0};
+
+	/**
+	 * @brief The WordDifficultyTypes value, 0 if the game was not started by difficulty.
+	 */
+	std::uint8_t difficulty{0};
+
+	/**
+	 * @brief WON, LOST, or IN_PROGRESS for an abandoned game.
+	 */
+	GameStatus outcome{GameStatus::NOT_STARTED};
+
+	/**
+	 * @brief The number of the word in its dictionary, no value if the word is stored instead.
+	 */
+	std::optional<std::uint32_t> wordNumber;
+
+	/**
+	 * @brief The word, only for a game whose word was not picked from a dictionary.
+	 */
+	std::string word;
+
+	/**
+	 * @brief When the game started, in microseconds since the Unix epoch.
+	 */
+	std::uint64_t startMicros{0};
+
+	/**
+	 * @brief Every guess of the game, in order.
+	 */
+	std::vector<JournalGuess> guesses;
+};
+
+/**
+ * @class Journal
+ * @brief An append-only file of finished games in the binary format of JournalFormat.h.
+ *
+ * Games are recorded by a GameEngine given the journal (see GameEngine::setJournal()).
+ * Every thread appends its records to one of SHARD_COUNT buffers, picked once
+ * per thread, and a buffer is written to the file in one piece once it holds
+ * BUFFER_BYTES, so recording a game takes no system call. Records are only
+ * guaranteed to be in the file after flush() or the destructor.
+ */
+class Journal
+{
+public:
+	/**
+	 * @brief Opens a journal for appending, creating it if needed.
+	 *
+	 * A damaged or incomplete record left at the end by a crash is cut off, so
+	 * that the records appended after it can be read.
+	 *
+	 * @param fileToWrite The journal file.
+	 * @throws InvalidJournalException if the file cannot be opened, is not a journal of this version
+	 *                                 or its damaged tail cannot be cut off.
+	 */
+	explicit Journal(std::filesystem::path fileToWrite);
+
+	/**
+	 * @brief Writes the buffered records and closes the file.
+	 */
+	~Journal();
+
+	/**
+	 * @brief Deleted copy constructor, the journal owns its file.
+	 */
+	Journal(const Journal& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the journal owns its file.
+	 */
+	Journal& operator=(const Journal& other) = delete;
+
+	/**
+	 * @brief Appends a complete record to the calling thread's buffer.
+	 *
+	 * @param record The record, as built by GameRecord::finish().
+	 */
+	void append(std::string_view record);
+
+	/**
+	 * @brief Writes every buffered record to the file.
+	 *
+	 * @throws InvalidJournalException if the file cannot be written.
+	 */
+	void flush();
+
+	/**
+	 * @brief A buffer is written once it holds this many bytes.
+	 */
+	static constexpr std::size_t BUFFER_BYTES = std::size_t{64} << 10;
+
+	/**
+	 * @brief The number of record buffers.
+	 */
+	static constexpr std::size_t SHARD_COUNT = 16;
+
+private:
+	/**
+	 * @brief The records of the threads assigned to one buffer.
+	 */
+	struct alignas(64) Shard
+	{
+		/**
+		 * @brief Guards the records, only contended by threads sharing the buffer.
+		 */
+		std::mutex mutex;
+
+		/**
+		 * @brief Complete records not written yet.
+		 */
+		std::string records;
+	};
+
+	/**
+	 * @brief Writes records to the file.
+	 *
+	 * @param records Complete records.
+	 * @return True if they were written.
+	 */
+	bool write(std::string_view records);
+
+	/**
+	 * @brief The journal file.
+	 */
+	std::filesystem::path path;
+
+	/**
+	 * @brief The record buffers.
+	 */
+	std::array<Shard, SHARD_COUNT> shards;
+
+	/**
+	 * @brief Serialises writes to the file.
+	 */
+	std::mutex fileMutex;
+
+	/**
+	 * @brief The file, open for appending.
+	 */
+	std::ofstream file;
+};
+
+/**
+ * @class GameRecord
+ * @brief Collects the events of the game in progress of one engine and encodes them as a journal record.
+ */
+class GameRecord
+{
+public:
+	/**
+	 * @brief Starts recording a game.
+	 *
+	 * @param seed The seed the engine was last given.
+	 * @param fingerprint The fingerprint of the word's dictionary, 0 for none.
+	 * @param difficulty The WordDifficultyTypes value, 0 for none.
+	 * @param wordNumber The number of the word in its dictionary, if it was picked from one.
+	 * @param word The word, stored only without a word number.
+	 */
+	void start(std::uint64_t seed, std::uint32_t fingerprint, std::uint8_t difficulty,
+	           std::optional<std::uint32_t> wordNumber, std::string_view word);
+
+	/**
+	 * @brief Records a guess, timed from the previous event.
+	 *
+	 * @param letter The guessed character.
+	 */
+	void guess(char letter);
+
+	/**
+	 * @brief Ends the game and appends its record to a journal.
+	 *
+	 * @param journal The journal.
+	 * @param outcome WON, LOST, or IN_PROGRESS for an abandoned game.
+	 */
+	void finish(Journal& journal, GameStatus outcome);
+
+	/**
+	 * @return True between start() and finish().
+	 */
+	[[nodiscard]] bool active() const { return recording; }
+
+private:
+	/**
+	 * @brief The payload up to and excluding the guesses.
+	 */
+	std::string head;
+
+	/**
+	 * @brief The encoded guesses.
+	 */
+	std::string guesses;
+
+	/**
+	 * @brief The complete record, reused between games.
+	 */
+	std::string record;
+
+	/**
+	 * @brief The number of guesses recorded.
+	 */
+	std::uint64_t guessCount{0};
+
+	/**
+	 * @brief The position of the outcome byte in `head`.
+	 */
+	std::size_t outcomeOffset{0};
+
+	/**
+	 * @brief When the last event was recorded.
+	 */
+	std::chrono::steady_clock::time_point lastEvent;
+
+	/**
+	 * @brief Whether a game is being recorded.
+	 */
+	bool recording{false};
+};
+
+/**
+ * @class JournalReader
+ * @brief Reads the games of a journal in file order.
+ */
+class JournalReader
+{
+public:
+	/**
+	 * @brief Maps a journal for reading.
+	 *
+	 * @param fileToRead The journal file.
+	 * @throws FileNotFoundException if the file cannot be opened.
+	 * @throws InvalidJournalException if the file is not a journal of this version.
+	 */
+	explicit JournalReader(const std::filesystem::path& fileToRead);
+
+	/**
+	 * @brief Reads the next game.
+	 *
+	 * @param game Receives the game, its buffers are reused.
+	 * @return False at the end of the journal or at a record cut short, see truncated().
+	 */
+	bool next(JournalGame& game);
+
+	/**
+	 * @return True if reading stopped at an incomplete or malformed record rather than at the end.
+	 */
+	[[nodiscard]] bool truncated() const { return offset < journal.size() && stopped; }
+
+	/**
+	 * @return The size of the header and of every record read so far, in bytes.
+	 */
+	[[nodiscard]] std::size_t validLength() const { return offset; }
+
+private:
+	/**
+	 * @brief The journal contents.
+	 */
+	MappedFile journal;
+
+	/**
+	 * @brief The position of the next record.
+	 */
+	std::size_t offset{0};
+
+	/**
+	 * @brief Set when a record could not be read.
+	 */
+	bool stopped{false};
+};
+
+#endif
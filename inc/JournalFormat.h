@@ -0,0 +1,77 @@
+#ifndef JOURNALFORMAT_H
+#define JOURNALFORMAT_H
+
+#include <cstdint>
+
+/**
+ * @brief Layout of a game journal.
+ *
+ * A journal is written by Journal and read by JournalReader. It starts with a
+ * Header, followed by one record per game, in the order games ended. Fixed-size
+ * integers use the byte order of the machine that wrote the file, varints are
+ * unsigned LEB128: seven bits per byte, least significant first, the high bit
+ * set on every byte but the last. A record is a varint payload length followed
+ * by the payload:
+ *
+ * 1. uint64 seed: the seed the engine was last given, 0 if it was never seeded.
+ * 2. uint32 dictionary fingerprint, see WordIndex::fingerprint(), 0 for a word
+ *    that was not picked from a dictionary.
+ * 3. uint8 difficulty: the WordDifficultyTypes value, 0 if the game was not
+ *    started by difficulty.
+ * 4. uint8 outcome: the GameStatus value, WON or LOST, or IN_PROGRESS for a game
+ *    abandoned by starting another.
+ * 5. varint word: the word number plus 1 (see WordListView::wordNumber()), or
+ *    0 followed by a varint length and the word itself.
+ * 6. varint start time in microseconds since the Unix epoch.
+ * 7. varint number of guesses, then for every guess the guessed character as
+ *    one byte and a varint of the microseconds since the previous guess, or
+ *    since the start for the first one.
+ *
+ * Every letter handed to the engine during the game is recorded, repeated ones
+ * included, so replaying the guesses reproduces the game exactly. Characters
+ * that are not letters change nothing and are left out, and TIMED_OUT stands
+ * for a turn that ran out of time (see GameEngine::timeOut()).
+ * A record cut short by a crash ends the readable part of the journal.
+ */
+namespace JournalFormat
+{
+	/**
+	 * @brief Identifies a journal file.
+	 */
+	constexpr char MAGIC[8] = {'H', 'G', 'M', 'J', 'R', 'N', 'L', '\0'};
+
+	/**
+	 * @brief The format version.
+	 */
+	constexpr std::uint32_t VERSION = 1;
+
+	/**
+	 * @brief The guessed character recorded for a turn that ran out of time.
+	 */
+	constexpr char TIMED_OUT = '\0';
+
+	/**
+	 * @brief The fixed-size header at the start of a journal.
+	 */
+	struct Header
+	{
+		/**
+		 * @brief Always MAGIC.
+		 */
+		char magic[8];
+
+		/**
+		 * @brief Always VERSION.
+		 */
+		std::uint32_t version;
+
+		/**
+		 * @brief Unused, zero.
+		 */
+		std::uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 16, "the header layout is part of the file format");
+}
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct LeaderboardEntry
+ * @brief One player on the leaderboard.
+ */
+struct LeaderboardEntry
+{
+	/**
+	 * @brief The player's name.
+	 */
+	std::string name;
+
+	/**
+	 * @brief The player's best score submitted.
+	 */
+	std::int64_t score{0};
+
+	/**
+	 * @brief Ranks higher scores first and equal scores by name.
+	 *
+	 * @param other The entry to compare with.
+	 * @return True if this entry ranks above the other.
+	 */
+	bool operator<(const LeaderboardEntry& other) const
+	{
+		return score != other.score ? score > other.score : name < other.name;
+	}
+};
+
+/**
+ * @brief A published leaderboard, best first. It never changes once published.
+ */
+using LeaderboardSnapshot = std::vector<LeaderboardEntry>;
+
+/**
+ * @class Leaderboard
+ * @brief The best `capacity` players by score, updated from many threads and read without locks.
+ *
+ * Threads submit scores into one of SHARD_COUNT buffers, picked once per
+ * thread, so game threads only meet when there are more of them than shards.
+ * A merge, run every merge interval by a background thread or on request,
+ * drains the buffers into the ranking and publishes it as an immutable
+ * snapshot; reading the leaderboard is one atomic load and costs O(capacity)
+ * to walk, however many players there are.
+ *
+ * A player's entry holds the best score submitted for them, so submitting
+ * running totals keeps it current. Only the ranked players are tracked, as
+ * nobody outside can pass one of them without a new score of their own, and
+ * scores below the lowest ranked one are dropped by submit() before they
+ * reach a buffer.
+ */
+class Leaderboard
+{
+public:
+	/**
+	 * @brief Creates an empty leaderboard.
+	 *
+	 * @param capacity The number of players ranked.
+	 * @param mergeInterval How often submitted scores are merged, 0 to merge on refresh() only.
+	 */
+	explicit Leaderboard(std::size_t capacity = DEFAULT_CAPACITY,
+	                     std::chrono::milliseconds mergeInterval = DEFAULT_MERGE_INTERVAL);
+
+	/**
+	 * @brief Stops the background merge.
+	 */
+	~Leaderboard();
+
+	/**
+	 * @brief Deleted copy constructor, the leaderboard owns its merge thread.
+	 */
+	Leaderboard(const Leaderboard& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the leaderboard owns its merge thread.
+	 */
+	Leaderboard& operator=(const Leaderboard& other) = delete;
+
+	/**
+	 * @brief Submits a player's score, visible after the next merge.
+	 *
+	 * @param name The player's name.
+	 * @param score The score, ignored unless it beats the player's entry.
+	 */
+	void submit(std::string_view name, std::int64_t score);
+
+	/**
+	 * @brief Merges the submitted scores now and publishes the result.
+	 */
+	void refresh();
+
+	/**
+	 * @return The leaderboard as of the last merge, best first.
+	 */
+	[[nodiscard]] std::shared_ptr<const LeaderboardSnapshot> top() const;
+
+	/**
+	 * @return The number of players ranked.
+	 */
+	[[nodiscard]] std::size_t capacity() const { return limit; }
+
+	/**
+	 * @brief The default number of players ranked.
+	 */
+	static constexpr std::size_t DEFAULT_CAPACITY = 100;
+
+	/**
+	 * @brief The default time between merges.
+	 */
+	static constexpr std::chrono::milliseconds DEFAULT_MERGE_INTERVAL{100};
+
+	/**
+	 * @brief The number of submission buffers.
+	 */
+	static constexpr std::size_t SHARD_COUNT = 16;
+
+private:
+	/**
+	 * @brief The scores submitted by the threads assigned to one buffer.
+	 */
+	struct alignas(64) Shard
+	{
+		/**
+		 * @brief Guards the submissions, only contended by threads sharing the buffer and by the merge.
+		 */
+		std::mutex mutex;
+
+		/**
+		 * @brief The scores submitted since the last merge.
+		 */
+		std::vector<LeaderboardEntry> submissions;
+	};
+
+	/**
+	 * @brief Body of the background thread, calls refresh() every merge interval until stopped.
+	 */
+	void mergeLoop();
+
+	/**
+	 * @brief The number of players ranked.
+	 */
+	std::size_t limit;
+
+	/**
+	 * @brief The time between merges, 0 for no background merge.
+	 */
+	std::chrono::milliseconds mergeInterval;
+
+	/**
+	 * @brief The submission buffers.
+	 */
+	std::array<Shard, SHARD_COUNT> shards;
+
+	/**
+	 * @brief The lowest ranked score of a full leaderboard, lower scores cannot enter it.
+	 */
+	std::atomic<std::int64_t> threshold{std::numeric_limits<std::int64_t>::min()};
+
+	/**
+	 * @brief Serialises merges and guards the members below.
+	 */
+	std::mutex mergeMutex;
+
+	/**
+	 * @brief The ranked players, best first.
+	 */
+	std::set<LeaderboardEntry> ranking;
+
+	/**
+	 * @brief The score of every ranked player, by name.
+	 */
+	std::unordered_map<std::string, std::int64_t> ranked;
+
+	/**
+	 * @brief The published leaderboard, only accessed with std::atomic_load and std::atomic_store.
+	 */
+	std::shared_ptr<const LeaderboardSnapshot> published;
+
+	/**
+	 * @brief Guards stopping.
+	 */
+	std::mutex stopMutex;
+
+	/**
+	 * @brief Wakes the background thread to stop.
+	 */
+	std::condition_variable wake;
+
+	/**
+	 * @brief Set by the destructor to end the background thread.
+	 */
+	bool stopping{false};
+
+	/**
+	 * @brief Merges in the background, not started for a merge interval of 0.
+	 */
+	std::thread merger;
+};
+
+#endif
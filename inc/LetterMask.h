@@ -0,0 +1,74 @@
+#ifndef LETTERMASK_H
+#define LETTERMASK_H
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief A set of letters 'a' to 'z', one bit per letter with 'a' in bit 0.
+ *
+ * Letters are case-insensitive. Characters outside the alphabet have no bit.
+ */
+using LetterMask = std::uint32_t;
+
+/**
+ * @brief The mask containing every letter from 'a' to 'z'.
+ */
+constexpr LetterMask ALL_LETTERS_MASK = (LetterMask{1} << 26) - 1;
+
+/**
+ * @brief Retrieves the bit that represents a letter.
+ *
+ * @param letter The letter, in either case.
+ * @return The bit for the letter, or 0 if the character is not a letter.
+ */
+constexpr LetterMask letterBit(const char letter)
+{
+	if (letter >= 'a' && letter <= 'z')
+	{
+		return LetterMask{1} << (letter - 'a');
+	}
+	if (letter >= 'A' && letter <= 'Z')
+	{
+		return LetterMask{1} << (letter - 'A');
+	}
+	return 0;
+}
+
+/**
+ * @brief Computes the set of distinct letters in a word.
+ *
+ * @param word The word.
+ * @return A mask with the bit of every letter that occurs in the word.
+ */
+constexpr LetterMask letterMaskOf(const std::string_view word)
+{
+	LetterMask mask = 0;
+	for (const char letter : word)
+	{
+		mask |= letterBit(letter);
+	}
+	return mask;
+}
+
+/**
+ * @brief Counts the letters in a mask.
+ *
+ * @param mask The set of letters.
+ * @return The number of letters in the set.
+ */
+constexpr int letterCount(const LetterMask mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+	for (LetterMask rest = mask; rest != 0; rest &= rest - 1)
+	{
+		++count;
+	}
+	return count;
+#endif
+}
+
+#endif
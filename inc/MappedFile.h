@@ -0,0 +1,98 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * The mapping lives as long as the object and is released by the destructor.
+ * On POSIX systems the file is mapped with mmap, so reading it costs no heap
+ * allocation and pages are only faulted in when touched. Elsewhere the file
+ * is read into a single buffer instead.
+ */
+class MappedFile
+{
+public:
+	/**
+	 * @brief Constructs an empty mapping.
+	 */
+	MappedFile() = default;
+
+	/**
+	 * @brief Maps the given file into memory.
+	 *
+	 * @param fileToMap Path to the file to map.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 */
+	explicit MappedFile(const std::filesystem::path& fileToMap);
+
+	/**
+	 * @brief Releases the mapping.
+	 */
+	~MappedFile();
+
+	/**
+	 * @brief Deleted copy constructor, a mapping has a single owner.
+	 */
+	MappedFile(const MappedFile& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, a mapping has a single owner.
+	 */
+	MappedFile& operator=(const MappedFile& other) = delete;
+
+	/**
+	 * @brief Transfers the mapping from another instance, leaving it empty.
+	 *
+	 * @param other The instance to take the mapping from.
+	 */
+	MappedFile(MappedFile&& other) noexcept;
+
+	/**
+	 * @brief Releases the current mapping and takes over the mapping of another instance.
+	 *
+	 * @param other The instance to take the mapping from.
+	 * @return This instance.
+	 */
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/**
+	 * @return The contents of the file, valid for the lifetime of the mapping.
+	 */
+	[[nodiscard]] std::string_view contents() const { return {address, length}; }
+
+	/**
+	 * @return The size of the mapped file in bytes.
+	 */
+	[[nodiscard]] std::size_t size() const { return length; }
+
+private:
+	/**
+	 * @brief Releases the mapping, if any, and resets the instance to empty.
+	 */
+	void release() noexcept;
+
+	/**
+	 * @brief Start of the mapped file contents.
+	 */
+	const char* address{nullptr};
+
+	/**
+	 * @brief Size of the mapped file in bytes.
+	 */
+	std::size_t length{0};
+
+#ifdef _WIN32
+	/**
+	 * @brief Holds the file contents on platforms without mmap.
+	 */
+	std::string buffer;
+#endif
+};
+
+#endif
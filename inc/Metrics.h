@@ -0,0 +1,345 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum MetricCounter
+ * @brief The event counters kept by Metrics.
+ *
+ * - GAMES_STARTED: Games started by any GameEngine.
+ * - GAMES_WON: Games that ended with the word guessed.
+ * - GAMES_LOST: Games that ended with the attempts used up.
+ * - GUESSES: Characters handed to GameEngine::guess() while a game is in progress, letters or not.
+ * - DICTIONARY_LOADS: Dictionaries loaded or reloaded by a DictionaryStore.
+ */
+enum class MetricCounter {
+    GAMES_STARTED,
+    GAMES_WON,
+    GAMES_LOST,
+    GUESSES,
+    DICTIONARY_LOADS
+};
+
+/**
+ * @brief The number of MetricCounter values.
+ */
+constexpr std::size_t METRIC_COUNTER_COUNT = 5;
+
+/**
+ * @enum MetricHistogram
+ * @brief The latency histograms kept by Metrics.
+ *
+ * - DICTIONARY_LOAD: Loading a dictionary in a DictionaryStore.
+ * - WORD_PICK: Picking a word and setting up a new game in GameEngine, sampled.
+ * - GUESS: Applying one guess in GameEngine::guess(), sampled.
+ * - RENDER: Rendering and writing one console frame in GameManager::draw().
+ */
+enum class MetricHistogram {
+    DICTIONARY_LOAD,
+    WORD_PICK,
+    GUESS,
+    RENDER
+};
+
+/**
+ * @brief The number of MetricHistogram values.
+ */
+constexpr std::size_t METRIC_HISTOGRAM_COUNT = 4;
+
+/**
+ * @struct HistogramSnapshot
+ * @brief The merged contents of one latency histogram.
+ *
+ * Durations are kept in nanoseconds in log-linear buckets in the manner of an
+ * HDR histogram: every power of two is split into SUB_BUCKETS equal buckets, so
+ * any recorded value is known to within 1/SUB_BUCKETS of itself, from one
+ * nanosecond up to centuries, in a fixed number of counters.
+ */
+struct HistogramSnapshot
+{
+	/**
+	 * @brief The base two logarithm of SUB_BUCKETS.
+	 */
+	static constexpr unsigned SUB_BUCKET_BITS = 4;
+
+	/**
+	 * @brief The number of buckets per power of two.
+	 */
+	static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+
+	/**
+	 * @brief The number of buckets needed for any 64 bit value.
+	 */
+	static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	/**
+	 * @brief Finds the bucket of a value.
+	 *
+	 * @param value The value in nanoseconds.
+	 * @return The bucket index, less than BUCKET_COUNT.
+	 */
+	static std::size_t bucketOf(std::uint64_t value);
+
+	/**
+	 * @brief Retrieves the smallest value of a bucket.
+	 *
+	 * @param bucket The bucket index, at most BUCKET_COUNT.
+	 * @return The smallest value in nanoseconds that falls into the bucket.
+	 */
+	static std::uint64_t lowerBound(std::size_t bucket);
+
+	/**
+	 * @brief Estimates a quantile of the recorded values.
+	 *
+	 * @param quantile The quantile, between 0 and 1.
+	 * @return The largest value of the bucket holding the quantile, capped at `max`, 0 if empty.
+	 */
+	[[nodiscard]] std::uint64_t valueAt(double quantile) const;
+
+	/**
+	 * @brief Counts the recorded values up to a bound.
+	 *
+	 * @param bound The bound in nanoseconds.
+	 * @return The number of values in buckets that lie entirely at or below the bound.
+	 */
+	[[nodiscard]] std::uint64_t countAtOrBelow(std::uint64_t bound) const;
+
+	/**
+	 * @brief The number of values in every bucket.
+	 */
+	std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+
+	/**
+	 * @brief The number of values recorded.
+	 */
+	std::uint64_t count{0};
+
+	/**
+	 * @brief The sum of the values recorded, in nanoseconds.
+	 */
+	std::uint64_t sum{0};
+
+	/**
+	 * @brief The largest value recorded, in nanoseconds.
+	 */
+	std::uint64_t max{0};
+};
+
+/**
+ * @struct MetricsSnapshot
+ * @brief The values of every counter and histogram at one point in time, summed over all threads.
+ */
+struct MetricsSnapshot
+{
+	/**
+	 * @brief The counters, indexed by MetricCounter.
+	 */
+	std::array<std::uint64_t, METRIC_COUNTER_COUNT> counters{};
+
+	/**
+	 * @brief The histograms, indexed by MetricHistogram.
+	 */
+	std::array<HistogramSnapshot, METRIC_HISTOGRAM_COUNT> histograms{};
+
+	/**
+	 * @param counter The counter.
+	 * @return The value of the counter.
+	 */
+	[[nodiscard]] std::uint64_t operator[](MetricCounter counter) const
+	{
+		return counters[static_cast<std::size_t>(counter)];
+	}
+
+	/**
+	 * @param histogram The histogram.
+	 * @return The contents of the histogram.
+	 */
+	[[nodiscard]] const HistogramSnapshot& operator[](MetricHistogram histogram) const
+	{
+		return histograms[static_cast<std::size_t>(histogram)];
+	}
+
+	/**
+	 * @brief Formats the snapshot in the Prometheus text exposition format.
+	 *
+	 * Counters become `hangman_<name>_total` counters, histograms become
+	 * `hangman_<name>_duration_seconds` histograms with buckets from 100 ns to
+	 * 10 s. The metric names are listed in Metrics.cpp.
+	 *
+	 * @return The exposition, one sample per line.
+	 */
+	[[nodiscard]] std::string prometheus() const;
+
+	/**
+	 * @brief Formats the snapshot as a single line JSON object.
+	 *
+	 * The object has a "counters" object of counter values and a "histograms"
+	 * object with count, sum, max, p50, p90, p99 and p999 in nanoseconds per histogram.
+	 *
+	 * @return The JSON text, without a trailing newline.
+	 */
+	[[nodiscard]] std::string json() const;
+};
+
+/**
+ * @class Metrics
+ * @brief Process-wide counters and latency histograms for the hot paths.
+ *
+ * Every thread records into its own shard of counters, so recording never
+ * takes a lock and never contends: it is a relaxed load and store by the only
+ * writer. A snapshot sums the shards of all threads; it may miss updates made
+ * while it is taken but never sees torn values. The shard of a thread that
+ * exits keeps its values and is handed to the next thread that starts recording.
+ *
+ * Reading the clock costs several times as much as a guess, so operations that
+ * run millions of times per second are timed for one call in
+ * HOT_PATH_SAMPLE_INTERVAL only (see sampleNext()). Their histograms count the
+ * timed calls, the counters count every call. Recording can be switched off
+ * for the whole process, which leaves one relaxed load per event; hangman_sim
+ * does so unless it is asked to print the metrics.
+ */
+class Metrics
+{
+public:
+	/**
+	 * @brief Adds to a counter, unless recording is switched off.
+	 *
+	 * @param counter The counter.
+	 * @param amount The amount to add.
+	 */
+	static void increment(const MetricCounter counter, const std::uint64_t amount = 1)
+	{
+		if (enabled())
+		{
+			add(counter, amount);
+		}
+	}
+
+	/**
+	 * @brief Records a duration in a histogram, unless recording is switched off.
+	 *
+	 * @param histogram The histogram.
+	 * @param duration The duration, negative durations count as 0.
+	 */
+	static void record(MetricHistogram histogram, std::chrono::nanoseconds duration);
+
+	/**
+	 * @brief Switches recording on or off for every thread. It is on at startup.
+	 *
+	 * @param enable True to record, false to ignore every event.
+	 */
+	static void setEnabled(const bool enable) { recording.store(enable, std::memory_order_relaxed); }
+
+	/**
+	 * @return True if events are recorded.
+	 */
+	[[nodiscard]] static bool enabled() { return recording.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Sums the shards of all threads.
+	 *
+	 * @return The current values.
+	 */
+	[[nodiscard]] static MetricsSnapshot snapshot();
+
+	/**
+	 * @brief Decides whether the calling thread times its next hot path operation.
+	 *
+	 * @return True for every HOT_PATH_SAMPLE_INTERVAL-th call on a thread, never while recording is off.
+	 */
+	[[nodiscard]] static bool sampleNext() { return enabled() && sampleDue(); }
+
+	/**
+	 * @brief One in this many hot path operations of a thread is timed.
+	 */
+	static constexpr std::uint32_t HOT_PATH_SAMPLE_INTERVAL = 64;
+
+private:
+	/**
+	 * @brief Adds to a counter in the calling thread's shard.
+	 *
+	 * @param counter The counter.
+	 * @param amount The amount to add.
+	 */
+	static void add(MetricCounter counter, std::uint64_t amount);
+
+	/**
+	 * @brief Counts down the calling thread's operations to the next sample.
+	 *
+	 * @return True if the next operation should be timed.
+	 */
+	static bool sampleDue();
+
+	/**
+	 * @brief Whether events are recorded.
+	 */
+	inline static std::atomic<bool> recording{true};
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the time from its construction to its destruction in a histogram.
+ */
+class ScopedTimer
+{
+public:
+	/**
+	 * @brief Starts timing.
+	 *
+	 * @param histogram The histogram that receives the duration.
+	 * @param active False to neither read the clock nor record anything, for unsampled calls.
+	 */
+	explicit ScopedTimer(const MetricHistogram histogram, const bool active = true) :
+		histogram(histogram), active(active)
+	{
+		if (active)
+		{
+			start = std::chrono::steady_clock::now();
+		}
+	}
+
+	/**
+	 * @brief Records the elapsed time.
+	 */
+	~ScopedTimer()
+	{
+		if (active)
+		{
+			Metrics::record(histogram, std::chrono::steady_clock::now() - start);
+		}
+	}
+
+	/**
+	 * @brief Deleted copy constructor, a timer records once.
+	 */
+	ScopedTimer(const ScopedTimer& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, a timer records once.
+	 */
+	ScopedTimer& operator=(const ScopedTimer& other) = delete;
+
+private:
+	/**
+	 * @brief The histogram that receives the duration.
+	 */
+	MetricHistogram histogram;
+
+	/**
+	 * @brief Whether this timer records.
+	 */
+	bool active;
+
+	/**
+	 * @brief When timing started.
+	 */
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif
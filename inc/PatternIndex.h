@@ -0,0 +1,161 @@
+#ifndef PATTERNINDEX_H
+#define PATTERNINDEX_H
+
+#include <LetterMask.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class WordListView;
+
+/**
+ * @class PatternIndex
+ * @brief Answers hangman pattern queries over one length bucket with bitset operations.
+ *
+ * For the words of one length, the index keeps a bitset of the words holding
+ * each letter at each position and a bitset of the words containing each
+ * letter at all, bit i standing for the i-th word of the bucket. A query such
+ * as `_a__e` with r and s excluded is then an AND of the bitsets of the
+ * revealed letters at their positions, an AND NOT of the bitsets of those
+ * letters at the hidden positions and an AND NOT of the "contains" bitsets of
+ * the excluded letters, a few passes over contiguous 64 bit blocks that the
+ * compiler vectorizes, whatever the words look like.
+ *
+ * Letters are case-insensitive; other characters are not indexed. Obtain the
+ * index of a bucket from WordIndex::patternIndex(), which builds it once.
+ */
+class PatternIndex
+{
+public:
+	/**
+	 * @brief Indexes a list of same-length words.
+	 *
+	 * The index refers to the words by position only and does not keep them alive.
+	 *
+	 * @param words The words, as produced by WordIndex::wordsOfLength.
+	 */
+	explicit PatternIndex(const WordListView& words);
+
+	/**
+	 * @brief Finds the words consistent with a game state.
+	 *
+	 * A match shows the revealed letters at exactly the positions of the pattern,
+	 * has no revealed letter at a hidden position and contains no excluded letter,
+	 * the rules of Solver::update().
+	 *
+	 * @param pattern The masked word, with '_' for every hidden letter. A pattern
+	 *                of another length, or revealing a character that is not a
+	 *                letter, matches no word.
+	 * @param excluded The letters the words must not contain.
+	 * @param matches Receives blockCount() blocks with the bit of every matching word set.
+	 * @return The number of matching words.
+	 */
+	std::size_t match(std::string_view pattern, LetterMask excluded, std::vector<std::uint64_t>& matches) const;
+
+	/**
+	 * @brief Calls a function with the position of every word whose bit is set, in ascending order.
+	 *
+	 * @param bits Bitset blocks, as filled by match().
+	 * @param visit Called with the position of each word.
+	 */
+	template <typename Visit>
+	static void forEach(const std::vector<std::uint64_t>& bits, Visit&& visit)
+	{
+		for (std::size_t block = 0; block < bits.size(); ++block)
+		{
+			for (std::uint64_t rest = bits[block]; rest != 0; rest &= rest - 1)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				const auto bit = static_cast<std::size_t>(__builtin_ctzll(rest));
+#else
+				std::size_t bit = 0;
+				while (((rest >> bit) & 1) == 0)
+				{
+					++bit;
+				}
+#endif
+				visit(block * 64 + bit);
+			}
+		}
+	}
+
+	/**
+	 * @brief Retrieves the words holding a letter at a position.
+	 *
+	 * @param position The position, less than wordLength().
+	 * @param letter The letter, in either case.
+	 * @return blockCount() blocks, or nullptr if the character is not a letter.
+	 */
+	[[nodiscard]] const std::uint64_t* positionBits(std::size_t position, char letter) const;
+
+	/**
+	 * @brief Retrieves the words containing a letter.
+	 *
+	 * @param letter The letter, in either case.
+	 * @return blockCount() blocks, or nullptr if the character is not a letter.
+	 */
+	[[nodiscard]] const std::uint64_t* containsBits(char letter) const;
+
+	/**
+	 * @return The first word of the indexed list, to recognize views of it.
+	 */
+	[[nodiscard]] const std::string_view* begin() const { return first; }
+
+	/**
+	 * @return The number of indexed words.
+	 */
+	[[nodiscard]] std::size_t size() const { return count; }
+
+	/**
+	 * @return The length of the indexed words.
+	 */
+	[[nodiscard]] std::size_t wordLength() const { return length; }
+
+	/**
+	 * @return The number of 64 bit blocks in every bitset.
+	 */
+	[[nodiscard]] std::size_t blockCount() const { return blocks; }
+
+	/**
+	 * @brief The blocks a query combines at a time, so that its result stays in the L1 cache.
+	 */
+	static constexpr std::size_t CHUNK_BLOCKS = 256;
+
+private:
+	/**
+	 * @brief Retrieves a bitset by its row.
+	 *
+	 * @param row position * 26 + letter for a position bitset, wordLength() * 26 + letter for a "contains" bitset.
+	 * @return The first block of the bitset.
+	 */
+	[[nodiscard]] const std::uint64_t* row(const std::size_t row) const { return bits.data() + row * blocks; }
+
+	/**
+	 * @brief The first word of the indexed list.
+	 */
+	const std::string_view* first{nullptr};
+
+	/**
+	 * @brief The number of indexed words.
+	 */
+	std::size_t count{0};
+
+	/**
+	 * @brief The length of the indexed words.
+	 */
+	std::size_t length{0};
+
+	/**
+	 * @brief The number of 64 bit blocks in every bitset.
+	 */
+	std::size_t blocks{0};
+
+	/**
+	 * @brief The bitsets of every position and letter, then the "contains" bitset of every letter, blocks each.
+	 */
+	std::vector<std::uint64_t> bits;
+};
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef PLAYERSTORE_H
+#define PLAYERSTORE_H
+
+#include <types.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @struct PlayerProfile
+ * @brief What is kept about a player across sessions.
+ */
+struct PlayerProfile
+{
+	/**
+	 * @brief Adds the outcome of a game.
+	 *
+	 * A won game scores one point per attempt left plus one, times the
+	 * difficulty, and every WINS_PER_LEVEL wins raise the level by one.
+	 *
+	 * @param won True if the word was guessed.
+	 * @param attemptsLeft The attempts left when the game ended.
+	 * @param difficulty The difficulty of the word.
+	 */
+	void recordGame(bool won, int attemptsLeft, WordDifficultyTypes difficulty);
+
+	/**
+	 * @brief The number of wins per level.
+	 */
+	static constexpr std::uint32_t WINS_PER_LEVEL = 5;
+
+	/**
+	 * @brief The player's level, starting at 1.
+	 */
+	std::uint32_t level{1};
+
+	/**
+	 * @brief The points of all games won.
+	 */
+	std::int64_t score{0};
+
+	/**
+	 * @brief The number of games won.
+	 */
+	std::uint32_t wins{0};
+
+	/**
+	 * @brief The number of games lost.
+	 */
+	std::uint32_t losses{0};
+};
+
+/**
+ * @class PlayerStore
+ * @brief Persistent player profiles in an append-only log with an in-memory hash index.
+ *
+ * Every profile lives in memory, spread over SHARD_COUNT hash maps with a lock
+ * each, so concurrent sessions rarely wait for each other. Every change appends
+ * the complete profile to the log (see PlayerStoreFormat.h). Appends are
+ * buffered and written and synced in batches every sync interval by a
+ * background thread, so a crash or power loss loses at most the changes of
+ * the last interval and a change costs no disk access of its own.
+ *
+ * Opening a store loads the snapshot of the index and replays only the part of
+ * the log written after it. The store takes a new snapshot once the log has
+ * grown by CHECKPOINT_BYTES and compacts the log to one record per player
+ * once it has doubled in size since the last compaction, plus COMPACTION_SLACK.
+ * Both also happen on request and the destructor takes a final snapshot.
+ *
+ * All members are thread-safe. One directory must be used by one store at a time.
+ */
+class PlayerStore
+{
+public:
+	/**
+	 * @brief Opens the store in a directory, creating the directory and its files if needed.
+	 *
+	 * @param directory The directory holding the log and the snapshot.
+	 * @param syncInterval How often buffered changes are written and synced, 0 to
+	 *                     write and sync every change before update() returns.
+	 * @throws PlayerStoreException if the files cannot be created, opened or are not player store files.
+	 */
+	explicit PlayerStore(std::filesystem::path directory,
+	                     std::chrono::milliseconds syncInterval = DEFAULT_SYNC_INTERVAL);
+
+	/**
+	 * @brief Writes the buffered changes and a snapshot, then closes the log.
+	 */
+	~PlayerStore();
+
+	/**
+	 * @brief Deleted copy constructor, the store owns its files and thread.
+	 */
+	PlayerStore(const PlayerStore& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the store owns its files and thread.
+	 */
+	PlayerStore& operator=(const PlayerStore& other) = delete;
+
+	/**
+	 * @brief Looks up a player.
+	 *
+	 * @param name The player's name.
+	 * @return The profile, or std::nullopt for an unknown player.
+	 */
+	[[nodiscard]] std::optional<PlayerProfile> find(std::string_view name) const;
+
+	/**
+	 * @brief Changes a player's profile, creating it first for a new player.
+	 *
+	 * @param name The player's name, 1 to MAX_NAME_LENGTH bytes.
+	 * @param change Applied to the profile while its shard is locked, it must not use the store.
+	 * @return The changed profile.
+	 * @throws std::invalid_argument if the name is empty or too long.
+	 */
+	PlayerProfile update(std::string_view name, const std::function<void(PlayerProfile&)>& change);
+
+	/**
+	 * @brief Adds the outcome of a game to a player's profile, see PlayerProfile::recordGame().
+	 *
+	 * @param name The player's name.
+	 * @param won True if the word was guessed.
+	 * @param attemptsLeft The attempts left when the game ended.
+	 * @param difficulty The difficulty of the word.
+	 * @return The changed profile.
+	 * @throws std::invalid_argument if the name is empty or too long.
+	 */
+	PlayerProfile recordGame(std::string_view name, bool won, int attemptsLeft, WordDifficultyTypes difficulty);
+
+	/**
+	 * @return The number of players.
+	 */
+	[[nodiscard]] std::size_t size() const;
+
+	/**
+	 * @brief Calls a function for every player, one shard at a time.
+	 *
+	 * @param visit Called with the name and profile while the player's shard is locked, it must not use the store.
+	 */
+	void forEach(const std::function<void(std::string_view, const PlayerProfile&)>& visit) const;
+
+	/**
+	 * @brief Writes and syncs the buffered changes now.
+	 *
+	 * @throws PlayerStoreException if the log cannot be written.
+	 */
+	void flush();
+
+	/**
+	 * @brief Writes a snapshot of the index, so the next open replays no log.
+	 *
+	 * @throws PlayerStoreException if the log or the snapshot cannot be written.
+	 */
+	void checkpoint();
+
+	/**
+	 * @brief Rewrites the log with one record per player and takes a snapshot.
+	 *
+	 * Changes wait only while the profiles are copied, not while they are written.
+	 *
+	 * @throws PlayerStoreException if the new log or the snapshot cannot be written.
+	 */
+	void compact();
+
+	/**
+	 * @brief The longest player name in bytes.
+	 */
+	static constexpr std::size_t MAX_NAME_LENGTH = 64;
+
+	/**
+	 * @brief The default time between batched syncs.
+	 */
+	static constexpr std::chrono::milliseconds DEFAULT_SYNC_INTERVAL{10};
+
+	/**
+	 * @brief Log growth in bytes after which a new snapshot is taken.
+	 */
+	static constexpr std::uint64_t CHECKPOINT_BYTES = std::uint64_t{16} << 20;
+
+	/**
+	 * @brief Log growth in bytes, beyond doubling, after which the log is compacted.
+	 */
+	static constexpr std::uint64_t COMPACTION_SLACK = std::uint64_t{64} << 20;
+
+	/**
+	 * @brief The number of independently locked hash maps.
+	 */
+	static constexpr std::size_t SHARD_COUNT = 64;
+
+private:
+	/**
+	 * @brief The profiles whose names hash to one shard.
+	 */
+	struct Shard
+	{
+		/**
+		 * @brief Guards the profiles and the order of their records in the log.
+		 */
+		mutable std::mutex mutex;
+
+		/**
+		 * @brief The profiles by name.
+		 */
+		std::unordered_map<std::string, PlayerProfile> profiles;
+	};
+
+	/**
+	 * @param name The player's name.
+	 * @return The shard holding the player.
+	 */
+	[[nodiscard]] Shard& shardOf(std::string_view name);
+
+	/**
+	 * @param name The player's name.
+	 * @return The shard holding the player.
+	 */
+	[[nodiscard]] const Shard& shardOf(std::string_view name) const;
+
+	/**
+	 * @brief Loads the snapshot, replays the log after it and cuts off an unreadable tail.
+	 */
+	void open();
+
+	/**
+	 * @brief Loads the snapshot if it matches the log.
+	 *
+	 * @param logSize The size of the log in bytes.
+	 * @return The log offset replay starts from, the end of the log header if there is no usable snapshot.
+	 */
+	std::uint64_t loadSnapshot(std::uint64_t logSize);
+
+	/**
+	 * @brief Writes the buffered records to the log and syncs it. The caller holds ioMutex.
+	 *
+	 * @return False if the log could not be written, the records stay buffered.
+	 */
+	bool writePending();
+
+	/**
+	 * @brief Writes the buffered records and a snapshot. The caller holds ioMutex.
+	 */
+	void checkpointLocked();
+
+	/**
+	 * @brief Writes the buffered records, then takes a snapshot or compacts when the log has grown enough.
+	 */
+	void maintain();
+
+	/**
+	 * @brief Body of the background thread, calls maintain() every sync interval until stopped.
+	 */
+	void syncLoop();
+
+	/**
+	 * @brief The directory holding the log and the snapshot.
+	 */
+	std::filesystem::path directory;
+
+	/**
+	 * @brief The time between batched syncs, 0 to sync every change.
+	 */
+	std::chrono::milliseconds syncInterval;
+
+	/**
+	 * @brief The profiles, by hash of the name.
+	 */
+	std::array<Shard, SHARD_COUNT> shards;
+
+	/**
+	 * @brief Guards pending and stopping.
+	 */
+	std::mutex pendingMutex;
+
+	/**
+	 * @brief Records appended since the last write, in log order.
+	 */
+	std::string pending;
+
+	/**
+	 * @brief Wakes the background thread to stop.
+	 */
+	std::condition_variable wake;
+
+	/**
+	 * @brief Set by the destructor to end the background thread.
+	 */
+	bool stopping{false};
+
+	/**
+	 * @brief Serialises writing the log and the snapshot, and guards the members below.
+	 */
+	std::mutex ioMutex;
+
+	/**
+	 * @brief The log, open for appending.
+	 */
+	int logFile{-1};
+
+	/**
+	 * @brief The size of the log in bytes.
+	 */
+	std::uint64_t logLength{0};
+
+	/**
+	 * @brief The generation of the log, see PlayerStoreFormat::LogHeader.
+	 */
+	std::uint64_t generation{0};
+
+	/**
+	 * @brief The log length the current snapshot includes.
+	 */
+	std::uint64_t snapshotLength{0};
+
+	/**
+	 * @brief The log length after the last compaction, or when the store was opened.
+	 */
+	std::uint64_t compactedLength{0};
+
+	/**
+	 * @brief Writes the log in the background, not started for a sync interval of 0.
+	 */
+	std::thread syncer;
+};
+
+#endif
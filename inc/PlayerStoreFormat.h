@@ -0,0 +1,162 @@
+#ifndef PLAYERSTOREFORMAT_H
+#define PLAYERSTOREFORMAT_H
+
+#include <cstdint>
+
+/**
+ * @brief Layout of the files of a PlayerStore.
+ *
+ * A store directory holds two files, both in the byte order of the machine
+ * that wrote them:
+ *
+ * - The log, LOG_FILE: a LogHeader followed by records. Every change of a
+ *   profile appends one record with the complete new profile, so the last
+ *   record of a name holds its current values and replaying the log in order
+ *   rebuilds every profile. A record that fails its checksum, and everything
+ *   after it, is the remainder of an interrupted write and is cut off.
+ * - The snapshot, SNAPSHOT_FILE: a SnapshotHeader followed by one record per
+ *   player. It holds the profiles as of `logLength` bytes of the log with the
+ *   same `generation`, so opening a store only replays the log after that point.
+ *
+ * A record is a Record followed by `nameLength` bytes of the name, unpadded.
+ * The log is rewritten by compaction under a new generation, which makes any
+ * snapshot of the old log unusable rather than wrong.
+ */
+namespace PlayerStoreFormat
+{
+	/**
+	 * @brief The name of the log file in a store directory.
+	 */
+	constexpr const char* LOG_FILE = "players.log";
+
+	/**
+	 * @brief The name of the snapshot file in a store directory.
+	 */
+	constexpr const char* SNAPSHOT_FILE = "players.idx";
+
+	/**
+	 * @brief Identifies a log file.
+	 */
+	constexpr char LOG_MAGIC[8] = {'H', 'G', 'M', 'P', 'L', 'O', 'G', '\0'};
+
+	/**
+	 * @brief Identifies a snapshot file.
+	 */
+	constexpr char SNAPSHOT_MAGIC[8] = {'H', 'G', 'M', 'P', 'I', 'D', 'X', '\0'};
+
+	/**
+	 * @brief The format version of both files.
+	 */
+	constexpr std::uint32_t VERSION = 1;
+
+	/**
+	 * @brief The fixed-size header at the start of the log.
+	 */
+	struct LogHeader
+	{
+		/**
+		 * @brief Always LOG_MAGIC.
+		 */
+		char magic[8];
+
+		/**
+		 * @brief Always VERSION.
+		 */
+		std::uint32_t version;
+
+		/**
+		 * @brief Unused, zero.
+		 */
+		std::uint32_t reserved;
+
+		/**
+		 * @brief Changes every time the log is rewritten.
+		 */
+		std::uint64_t generation;
+	};
+
+	static_assert(sizeof(LogHeader) == 24, "the header layout is part of the file format");
+
+	/**
+	 * @brief The fixed-size header at the start of the snapshot.
+	 */
+	struct SnapshotHeader
+	{
+		/**
+		 * @brief Always SNAPSHOT_MAGIC.
+		 */
+		char magic[8];
+
+		/**
+		 * @brief Always VERSION.
+		 */
+		std::uint32_t version;
+
+		/**
+		 * @brief Unused, zero.
+		 */
+		std::uint32_t reserved;
+
+		/**
+		 * @brief The generation of the log the snapshot was taken from.
+		 */
+		std::uint64_t generation;
+
+		/**
+		 * @brief The size of the log in bytes that the snapshot includes.
+		 */
+		std::uint64_t logLength;
+
+		/**
+		 * @brief The number of records following the header.
+		 */
+		std::uint64_t playerCount;
+	};
+
+	static_assert(sizeof(SnapshotHeader) == 40, "the header layout is part of the file format");
+
+	/**
+	 * @brief The fixed-size part of a record, followed by the name.
+	 */
+	struct Record
+	{
+		/**
+		 * @brief FNV-1a hash of the record with this field set to 0, and of the name.
+		 */
+		std::uint32_t checksum;
+
+		/**
+		 * @brief The length of the name in bytes.
+		 */
+		std::uint32_t nameLength;
+
+		/**
+		 * @brief The player's level.
+		 */
+		std::uint32_t level;
+
+		/**
+		 * @brief The number of games won.
+		 */
+		std::uint32_t wins;
+
+		/**
+		 * @brief The number of games lost.
+		 */
+		std::uint32_t losses;
+
+		/**
+		 * @brief Unused, zero.
+		 */
+		std::uint32_t reserved;
+
+		/**
+		 * @brief The player's score.
+		 */
+		std::int64_t score;
+	};
+
+	static_assert(sizeof(Record) == 32, "the record layout is part of the file format");
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef RANDOMENGINE_H
+#define RANDOMENGINE_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class RandomEngine
+ * @brief A small, fast, seedable pseudo random number generator.
+ *
+ * Implements xoshiro256** (32 bytes of state) seeded through splitmix64, with
+ * unbiased bounded sampling by Lemire's multiply-and-reject method. An engine is
+ * meant to be owned by a game session and seeded once; seeding it explicitly
+ * makes every word pick reproducible, which simulations and replays rely on.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements, so it can
+ * also drive the standard library distributions and algorithms.
+ */
+class RandomEngine
+{
+public:
+	using result_type = std::uint64_t;
+
+	/**
+	 * @brief Constructs an engine seeded from std::random_device.
+	 */
+	RandomEngine();
+
+	/**
+	 * @brief Constructs an engine with a fixed seed.
+	 *
+	 * @param seed The seed. Equal seeds produce equal sequences.
+	 */
+	explicit RandomEngine(std::uint64_t seed) { setSeed(seed); }
+
+	/**
+	 * @brief Restarts the sequence from the given seed.
+	 *
+	 * @param seed The seed. Equal seeds produce equal sequences.
+	 */
+	void setSeed(std::uint64_t seed);
+
+	/**
+	 * @brief Draws a fresh seed from std::random_device.
+	 *
+	 * @return A non-deterministic seed.
+	 */
+	[[nodiscard]] static std::uint64_t randomSeed();
+
+	/**
+	 * @return The next 64 random bits.
+	 */
+	result_type operator()()
+	{
+		const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+		const std::uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+
+		return result;
+	}
+
+	/**
+	 * @brief Draws a uniformly distributed number in [0, bound).
+	 *
+	 * @param bound The exclusive upper bound. Must be greater than 0.
+	 * @return A number in [0, bound) without modulo bias.
+	 */
+	std::uint64_t below(const std::uint64_t bound)
+	{
+		std::uint64_t low = 0;
+		std::uint64_t high = multiply((*this)(), bound, low);
+		if (low < bound)
+		{
+			// Reject the few products that would make some results more likely
+			const std::uint64_t threshold = (0 - bound) % bound;
+			while (low < threshold)
+			{
+				high = multiply((*this)(), bound, low);
+			}
+		}
+		return high;
+	}
+
+	/**
+	 * @brief Draws a uniformly distributed integer in [min, max].
+	 *
+	 * @param min The lower bound, inclusive.
+	 * @param max The upper bound, inclusive. Must not be less than min.
+	 * @return A number in [min, max].
+	 */
+	int between(const int min, const int max)
+	{
+		const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+		return static_cast<int>(min + static_cast<std::int64_t>(below(range)));
+	}
+
+	/**
+	 * @brief Draws a uniformly distributed real number in [0, 1).
+	 *
+	 * @return A multiple of 2^-53 in [0, 1).
+	 */
+	double canonical()
+	{
+		return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+	}
+
+	/**
+	 * @return The smallest value operator() can return.
+	 */
+	static constexpr result_type min() { return 0; }
+
+	/**
+	 * @return The largest value operator() can return.
+	 */
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+	/**
+	 * @brief Rotates a 64 bit value left.
+	 */
+	static constexpr std::uint64_t rotl(const std::uint64_t x, const int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	/**
+	 * @brief Computes the full 128 bit product of two 64 bit values.
+	 *
+	 * @param a The first factor.
+	 * @param b The second factor.
+	 * @param low Receives the low 64 bits of the product.
+	 * @return The high 64 bits of the product.
+	 */
+	static std::uint64_t multiply(const std::uint64_t a, const std::uint64_t b, std::uint64_t& low)
+	{
+#ifdef __SIZEOF_INT128__
+		const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		low = static_cast<std::uint64_t>(product);
+		return static_cast<std::uint64_t>(product >> 64);
+#else
+		const std::uint64_t aLow = a & 0xffffffffu, aHigh = a >> 32;
+		const std::uint64_t bLow = b & 0xffffffffu, bHigh = b >> 32;
+		const std::uint64_t lowLow = aLow * bLow;
+		const std::uint64_t highLow = aHigh * bLow;
+		const std::uint64_t lowHigh = aLow * bHigh;
+		const std::uint64_t cross = (lowLow >> 32) + (highLow & 0xffffffffu) + lowHigh;
+		low = (cross << 32) | (lowLow & 0xffffffffu);
+		return aHigh * bHigh + (highLow >> 32) + (cross >> 32);
+#endif
+	}
+
+	/**
+	 * @brief The xoshiro256** state. Never all zero.
+	 */
+	std::uint64_t state[4]{};
+};
+
+#endif
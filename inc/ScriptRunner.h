@@ -0,0 +1,127 @@
+#ifndef SCRIPTRUNNER_H
+#define SCRIPTRUNNER_H
+
+#include <GameEngine.h>
+#include <Journal.h>
+#include <WordIndex.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @struct ScriptStats
+ * @brief What a script run did.
+ */
+struct ScriptStats
+{
+	/**
+	 * @brief Games reported, finished or not.
+	 */
+	std::uint64_t games{0};
+
+	/**
+	 * @brief Letters handed to the engine while a game was in progress.
+	 */
+	std::uint64_t guesses{0};
+
+	/**
+	 * @brief Lines rejected with an ERR result.
+	 */
+	std::uint64_t errors{0};
+};
+
+/**
+ * @class ScriptRunner
+ * @brief Plays games from a stream of commands, without prompts, for bulk and scripted runs.
+ *
+ * Every line of the input is one command, keywords are case-insensitive:
+ *
+ *     NEW <seed> [easy|medium|hard]   starts a game with a word picked for the seed, medium by default
+ *     WORD <word>                     starts a game with the given word
+ *     GUESS <letters>                 guesses the letters in order
+ *
+ * Blank lines and lines starting with '#' are skipped. Every game is reported
+ * with one line, `<STATUS> <word> <attempts left> <guesses>`, STATUS being the
+ * name of the GameStatus: WON or LOST as soon as the game ends, IN_PROGRESS if
+ * the next game or the end of the input comes first. Letters guessed after the
+ * end of a game are ignored. A line that cannot be executed is answered with
+ * `ERR <line number> <reason>` and skipped.
+ *
+ * Input is read and output written in blocks of BLOCK_SIZE bytes, nothing is
+ * flushed per line.
+ */
+class ScriptRunner
+{
+public:
+	/**
+	 * @brief Constructs a runner picking words from a dictionary.
+	 *
+	 * @param dictionary The dictionary NEW picks words from.
+	 */
+	explicit ScriptRunner(std::shared_ptr<const WordIndex> dictionary);
+
+	/**
+	 * @brief Records every game in a journal, see GameEngine::setJournal().
+	 *
+	 * @param journal The journal, or nullptr to stop recording.
+	 */
+	void setJournal(std::shared_ptr<Journal> journal);
+
+	/**
+	 * @brief Executes every command of the input.
+	 *
+	 * @param input The commands.
+	 * @param output Receives the results, written in blocks and not flushed.
+	 * @return What the run did.
+	 */
+	ScriptStats run(std::istream& input, std::ostream& output);
+
+	/**
+	 * @brief The size of the blocks input is read and output written in.
+	 */
+	static constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 20;
+
+private:
+	/**
+	 * @brief Executes one command.
+	 *
+	 * @param line The command, without the line terminator.
+	 * @param number The line number, from 1, for error messages.
+	 * @param results Receives the result lines.
+	 */
+	void execute(std::string_view line, std::uint64_t number, std::string& results);
+
+	/**
+	 * @brief Appends the result line of the current game unless it was reported already.
+	 *
+	 * @param results Receives the result line.
+	 */
+	void report(std::string& results);
+
+	/**
+	 * @brief Plays the games.
+	 */
+	GameEngine engine;
+
+	/**
+	 * @brief Letters handed to the engine during the current game.
+	 */
+	std::uint64_t gameGuesses{0};
+
+	/**
+	 * @brief Whether the current game still has to be reported.
+	 */
+	bool unreported{false};
+
+	/**
+	 * @brief Totals of the current run.
+	 */
+	ScriptStats stats;
+};
+
+#endif
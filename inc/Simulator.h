@@ -0,0 +1,177 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <GuessStrategy.h>
+#include <Journal.h>
+#include <WordIndex.h>
+#include <types.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct DifficultyStats
+ * @brief Totals over the simulated games of one difficulty.
+ */
+struct DifficultyStats
+{
+	/**
+	 * @brief Games played.
+	 */
+	std::uint64_t games{0};
+
+	/**
+	 * @brief Games won.
+	 */
+	std::uint64_t wins{0};
+
+	/**
+	 * @brief Letters guessed over all games, correct or not.
+	 */
+	std::uint64_t guesses{0};
+
+	/**
+	 * @brief Incorrect letters guessed over all games.
+	 */
+	std::uint64_t incorrectGuesses{0};
+
+	/**
+	 * @brief Adds the totals of another set of games.
+	 *
+	 * @param other The totals to add.
+	 */
+	void merge(const DifficultyStats& other);
+
+	/**
+	 * @return The fraction of games won, 0 if no game was played.
+	 */
+	[[nodiscard]] double winRate() const;
+
+	/**
+	 * @return The average number of guesses per game, 0 if no game was played.
+	 */
+	[[nodiscard]] double averageGuesses() const;
+};
+
+/**
+ * @struct SimulationStats
+ * @brief The merged result of a simulation run.
+ */
+struct SimulationStats
+{
+	/**
+	 * @brief Totals per difficulty, indexed by difficultyIndex().
+	 */
+	std::array<DifficultyStats, 3> byDifficulty{};
+
+	/**
+	 * @brief Wall clock duration of the run in seconds.
+	 */
+	double seconds{0.0};
+
+	/**
+	 * @brief Adds the totals of another set of games, the duration is not changed.
+	 *
+	 * @param other The totals to add.
+	 */
+	void merge(const SimulationStats& other);
+
+	/**
+	 * @return The totals over every difficulty.
+	 */
+	[[nodiscard]] DifficultyStats total() const;
+
+	/**
+	 * @return Games played per second of wall clock time.
+	 */
+	[[nodiscard]] double gamesPerSecond() const;
+
+	/**
+	 * @brief Maps a difficulty to its slot in byDifficulty.
+	 *
+	 * @param difficulty The difficulty.
+	 * @return The index of the difficulty.
+	 */
+	[[nodiscard]] static std::size_t difficultyIndex(WordDifficultyTypes difficulty);
+};
+
+/**
+ * @struct SimulationConfig
+ * @brief Describes a batch of automated games.
+ */
+struct SimulationConfig
+{
+	/**
+	 * @brief The dictionary words are picked from.
+	 */
+	std::shared_ptr<const WordIndex> dictionary;
+
+	/**
+	 * @brief Creates the guessing strategy, once per thread.
+	 */
+	GuessStrategyFactory strategy;
+
+	/**
+	 * @brief The number of games to play.
+	 */
+	std::uint64_t games{100000};
+
+	/**
+	 * @brief The number of threads, 0 for one per hardware thread.
+	 */
+	std::size_t threads{0};
+
+	/**
+	 * @brief Game i is seeded with seed + i, so results do not depend on the thread count.
+	 */
+	std::uint64_t seed{0};
+
+	/**
+	 * @brief Game i is played at difficulties[i % difficulties.size()].
+	 */
+	std::vector<WordDifficultyTypes> difficulties{WordDifficultyTypes::EASY, WordDifficultyTypes::MEDIUM,
+	                                              WordDifficultyTypes::HARD};
+
+	/**
+	 * @brief Records every game, nullptr for none. It is flushed when the run ends.
+	 */
+	std::shared_ptr<Journal> journal;
+};
+
+/**
+ * @class Simulator
+ * @brief Plays batches of games with an automated guesser across all cores.
+ *
+ * Games are split into fixed-size chunks that run on a work-stealing ThreadPool.
+ * Every worker keeps its own GameEngine, strategy and statistics, which are only
+ * merged once all games are done, so the game loop never synchronizes.
+ */
+class Simulator
+{
+public:
+	/**
+	 * @brief Plays the configured games.
+	 *
+	 * @param config What to simulate.
+	 * @return The merged statistics.
+	 */
+	[[nodiscard]] static SimulationStats run(const SimulationConfig& config);
+
+	/**
+	 * @brief Plays a single game to the end.
+	 *
+	 * @param game The engine to play on, the game must already be started.
+	 * @param strategy The guesser.
+	 * @param stats Receives the outcome of the game.
+	 */
+	static void playGame(GameEngine& game, GuessStrategy& strategy, DifficultyStats& stats);
+
+	/**
+	 * @brief The number of games one pool task plays.
+	 */
+	static constexpr std::uint64_t GAMES_PER_TASK = 1024;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <LetterMask.h>
+#include <PatternIndex.h>
+#include <WordIndex.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class Solver
+ * @brief Suggests the letter that best splits the words still consistent with a game.
+ *
+ * The solver starts from every dictionary word of the target's length and keeps
+ * the live candidate set, which it narrows in place each time it learns a new
+ * masked pattern and set of wrong letters, so every update only rescans the
+ * words that were still possible. The first narrowing of a large bucket, which
+ * would scan every word, is answered by the bucket's PatternIndex instead. The
+ * suggested letter is the one whose answer
+ * (the positions it would reveal, or a miss) has the highest entropy over the
+ * remaining candidates.
+ */
+class Solver
+{
+public:
+	/**
+	 * @brief Constructs a solver without candidates.
+	 */
+	Solver() = default;
+
+	/**
+	 * @brief Constructs a solver over a list of same-length words.
+	 *
+	 * @param words The words of the target's length, as produced by WordIndex::wordsOfLength.
+	 */
+	explicit Solver(const WordListView& words);
+
+	/**
+	 * @brief Restarts with every word of the list as a candidate.
+	 *
+	 * @param words The words of the target's length, as produced by WordIndex::wordsOfLength.
+	 */
+	void reset(const WordListView& words);
+
+	/**
+	 * @brief Narrows the candidates to the words consistent with the game state.
+	 *
+	 * A candidate must show the revealed letters at exactly the positions of the
+	 * pattern, must not have a revealed letter at any hidden position and must not
+	 * contain any wrong letter. Letters match in either case.
+	 *
+	 * @param pattern The masked word, with '_' for every hidden letter.
+	 * @param wrongLetters The letters known not to be in the word.
+	 */
+	void update(std::string_view pattern, LetterMask wrongLetters);
+
+	/**
+	 * @brief Picks the unguessed letter whose answer carries the most information.
+	 *
+	 * Ties go to the letter found in more candidates, which is more likely to be correct.
+	 *
+	 * @return The suggested letter, or '\0' when no letter can be suggested.
+	 */
+	[[nodiscard]] char bestGuess() const;
+
+	/**
+	 * @return The number of words still consistent with the game state.
+	 */
+	[[nodiscard]] std::size_t candidateCount() const { return candidates.size(); }
+
+	/**
+	 * @brief Retrieves a remaining candidate.
+	 *
+	 * @param index Position of the candidate, less than candidateCount().
+	 * @return The candidate word.
+	 */
+	[[nodiscard]] std::string_view candidate(std::size_t index) const { return words[candidates[index]]; }
+
+	/**
+	 * @brief Counts, for every letter, the candidates that contain it.
+	 *
+	 * @return The counts, with 'a' at index 0.
+	 */
+	[[nodiscard]] std::array<std::uint32_t, 26> letterCounts() const;
+
+	/**
+	 * @brief The smallest list of words whose first narrowing uses the pattern index.
+	 */
+	static constexpr std::size_t PATTERN_INDEX_MIN_WORDS = 1024;
+
+private:
+	/**
+	 * @brief Computes the entropy of the positions at which a letter would be revealed.
+	 *
+	 * @param letter The letter, from 'a' to 'z'.
+	 * @return The entropy in bits over the remaining candidates.
+	 */
+	[[nodiscard]] double revealEntropy(char letter) const;
+
+	/**
+	 * @brief Replaces the candidates by the matches of the pattern index, if it covers `words`.
+	 *
+	 * @param pattern The masked word, with '_' for every hidden letter.
+	 * @param wrongLetters The letters known not to be in the word.
+	 * @return True if the candidates were replaced, false if `words` has no pattern index.
+	 */
+	bool matchIndexed(std::string_view pattern, LetterMask wrongLetters);
+
+	/**
+	 * @brief The words of the target's length.
+	 */
+	WordListView words;
+
+	/**
+	 * @brief Positions in `words` of the remaining candidates.
+	 */
+	std::vector<std::uint32_t> candidates;
+
+	/**
+	 * @brief Letter masks of the remaining candidates, kept contiguous for vectorized counting.
+	 */
+	std::vector<LetterMask> candidateMasks;
+
+	/**
+	 * @brief Every letter that has been guessed, revealed or wrong.
+	 */
+	LetterMask guessedLetters{0};
+
+	/**
+	 * @brief The pattern index of the bucket `words` was taken from, fetched on first use.
+	 */
+	std::shared_ptr<const PatternIndex> patterns;
+
+	/**
+	 * @brief The matches of the last pattern index query.
+	 */
+	std::vector<std::uint64_t> matchBits;
+};
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed-size, work-stealing thread pool.
+ *
+ * Every worker owns a task queue. A worker takes tasks from the back of its own
+ * queue and, once that is empty, steals from the front of the other queues, so
+ * uneven tasks keep all workers busy. Tasks submitted from outside the pool are
+ * spread over the queues round-robin; tasks submitted by a worker go to its own
+ * queue.
+ *
+ * Submitting and taking tasks only locks the queue involved; the counts are
+ * atomic. The pool-wide mutex is only taken to park a worker that found
+ * nothing to do, to wake it and to wait for the tasks to finish.
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * @brief Starts the worker threads.
+	 *
+	 * @param threadCount The number of workers, at least 1. Defaults to one per hardware thread.
+	 */
+	explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+	/**
+	 * @brief Waits for all submitted tasks, then stops and joins the workers.
+	 */
+	~ThreadPool();
+
+	/**
+	 * @brief Deleted copy constructor, the pool owns its threads.
+	 */
+	ThreadPool(const ThreadPool& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the pool owns its threads.
+	 */
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	/**
+	 * @brief Queues a task for execution on one of the workers.
+	 *
+	 * @param task The task to run. If it throws, the exception is kept for wait().
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 * @brief Blocks until every submitted task has finished.
+	 *
+	 * @throws The first exception a task threw since the last wait(), once every task has finished.
+	 */
+	void wait();
+
+	/**
+	 * @return The number of worker threads.
+	 */
+	[[nodiscard]] std::size_t size() const { return workers.size(); }
+
+	/**
+	 * @brief Identifies the worker running the calling thread.
+	 *
+	 * Lets tasks keep per-worker state in an array indexed by worker without locking.
+	 *
+	 * @return The index of the calling worker in [0, size()), or NOT_A_WORKER outside the pool.
+	 */
+	[[nodiscard]] static std::size_t currentWorker();
+
+	/**
+	 * @brief Returned by currentWorker() on threads that do not belong to a pool.
+	 */
+	static constexpr std::size_t NOT_A_WORKER = static_cast<std::size_t>(-1);
+
+private:
+	/**
+	 * @brief A worker's task queue.
+	 */
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	/**
+	 * @brief The main loop of a worker thread.
+	 *
+	 * @param index The index of the worker.
+	 */
+	void workerLoop(std::size_t index);
+
+	/**
+	 * @brief Runs a task, keeps its exception if it throws and counts it finished.
+	 *
+	 * @param task The task.
+	 */
+	void run(std::function<void()>& task);
+
+	/**
+	 * @brief Takes a task from the worker's own queue or steals one from another queue.
+	 *
+	 * @param index The index of the worker looking for work.
+	 * @param task Receives the task.
+	 * @return True if a task was found.
+	 */
+	bool takeTask(std::size_t index, std::function<void()>& task);
+
+	/**
+	 * @brief One queue per worker, at the same index.
+	 */
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+
+	/**
+	 * @brief The worker threads.
+	 */
+	std::vector<std::thread> workers;
+
+	/**
+	 * @brief Guards stopping and firstError, and orders parking workers with the wake-ups.
+	 */
+	std::mutex stateMutex;
+
+	/**
+	 * @brief Signalled when a task is queued while a worker is parked, or the pool stops.
+	 */
+	std::condition_variable workAvailable;
+
+	/**
+	 * @brief Signalled when the last unfinished task completes.
+	 */
+	std::condition_variable allDone;
+
+	/**
+	 * @brief Tasks sitting in a queue, changed under the mutex of that queue.
+	 */
+	std::atomic<std::size_t> queuedTasks{0};
+
+	/**
+	 * @brief Tasks submitted but not yet finished.
+	 */
+	std::atomic<std::size_t> unfinishedTasks{0};
+
+	/**
+	 * @brief Workers parked on workAvailable, or about to be.
+	 */
+	std::atomic<std::size_t> parkedWorkers{0};
+
+	/**
+	 * @brief The queue that receives the next task submitted from outside the pool.
+	 */
+	std::atomic<std::size_t> nextQueue{0};
+
+	/**
+	 * @brief Set by the destructor to make the workers exit.
+	 */
+	bool stopping{false};
+
+	/**
+	 * @brief The first exception thrown by a task since the last wait().
+	 */
+	std::exception_ptr firstError;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * @file Trace.h
+ * @brief Scoped spans written as Chrome trace events, for builds configured with HANGMAN_TRACING=ON.
+ *
+ * Place HANGMAN_TRACE_SCOPE("name") at the top of a block to record the time
+ * spent in it. Without HANGMAN_TRACING the macro expands to an empty statement,
+ * so spans cost nothing and Tracer does not exist.
+ */
+
+#ifdef HANGMAN_TRACING
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+
+/**
+ * @class Tracer
+ * @brief Collects the spans of every thread and writes them in the Chrome trace event format.
+ *
+ * Every thread records into a ring buffer of its own that keeps its latest
+ * TRACE_BUFFER_EVENTS spans, so recording takes no lock after a thread's first
+ * span. The output is a JSON object with a "traceEvents" array of complete
+ * ("ph": "X") events, which chrome://tracing and Perfetto open directly.
+ */
+class Tracer
+{
+public:
+	/**
+	 * @brief Records a finished span on the calling thread.
+	 *
+	 * @param name The span name, a string literal or other string that lives
+	 *             for the rest of the program and needs no JSON escaping.
+	 * @param start When the span began.
+	 * @param end When the span ended.
+	 */
+	static void record(const char* name, std::chrono::steady_clock::time_point start,
+	                   std::chrono::steady_clock::time_point end);
+
+	/**
+	 * @brief Writes the recorded spans of every thread as Chrome trace JSON.
+	 *
+	 * Spans still open are not included. Call it while no other thread is recording.
+	 *
+	 * @param out The stream to write to.
+	 */
+	static void writeChromeTrace(std::ostream& out);
+
+	/**
+	 * @brief Writes the recorded spans of every thread to a file.
+	 *
+	 * @param fileToWrite Path of the trace file to create or replace.
+	 * @return True if the file was written successfully.
+	 */
+	static bool writeChromeTrace(const std::filesystem::path& fileToWrite);
+
+	/**
+	 * @brief The number of spans kept per thread; older spans are overwritten.
+	 */
+	static constexpr std::size_t TRACE_BUFFER_EVENTS = 1 << 16;
+};
+
+/**
+ * @class TraceSpan
+ * @brief Records the time from its construction to its destruction as a span.
+ */
+class TraceSpan
+{
+public:
+	/**
+	 * @brief Opens the span.
+	 *
+	 * @param name The span name, see Tracer::record().
+	 */
+	explicit TraceSpan(const char* name) : name(name), start(std::chrono::steady_clock::now())
+	{
+	}
+
+	/**
+	 * @brief Closes and records the span.
+	 */
+	~TraceSpan()
+	{
+		Tracer::record(name, start, std::chrono::steady_clock::now());
+	}
+
+	/**
+	 * @brief Deleted copy constructor, a span is recorded once.
+	 */
+	TraceSpan(const TraceSpan& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, a span is recorded once.
+	 */
+	TraceSpan& operator=(const TraceSpan& other) = delete;
+
+private:
+	/**
+	 * @brief The span name.
+	 */
+	const char* name;
+
+	/**
+	 * @brief When the span was opened.
+	 */
+	std::chrono::steady_clock::time_point start;
+};
+
+#define HANGMAN_TRACE_CONCAT_(a, b) a##b
+#define HANGMAN_TRACE_CONCAT(a, b) HANGMAN_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Records the rest of the enclosing block as a span with the given name.
+ */
+#define HANGMAN_TRACE_SCOPE(name) const TraceSpan HANGMAN_TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+#else
+
+/**
+ * @brief Compiled out, tracing is disabled.
+ */
+#define HANGMAN_TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif
+
+#endif
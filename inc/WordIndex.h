@@ -0,0 +1,610 @@
+#ifndef WORDINDEX_H
+#define WORDINDEX_H
+
+#include <AliasTable.h>
+#include <EmbeddedDictionary.h>
+#include <LetterMask.h>
+#include <MappedFile.h>
+#include <PatternIndex.h>
+#include <RandomEngine.h>
+#include <types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class WordIndex;
+
+/**
+ * @class WordListView
+ * @brief A read-only, random access view over a contiguous run of words in a WordIndex.
+ *
+ * Views are cheap to copy and never copy the words themselves. Each view shares
+ * ownership of the index it was taken from, so it stays valid even after the
+ * index has been dropped from the FileManager cache.
+ */
+class WordListView
+{
+public:
+	using const_iterator = const std::string_view*;
+
+	/**
+	 * @brief Constructs an empty view.
+	 */
+	WordListView() = default;
+
+	/**
+	 * @brief Constructs a view over the range [first, last) owned by an index.
+	 *
+	 * @param first Pointer to the first word of the range.
+	 * @param last Pointer one past the last word of the range.
+	 * @param masks Pointer to the letter mask of the first word, followed by those of the other words.
+	 * @param weights Pointer to the weight of the first word, followed by those of the other words,
+	 *                or nullptr if every word weighs 1.
+	 * @param scores Pointer to the difficulty score of the first word, followed by those of the other words.
+	 * @param sampler Picks the words of exactly this range by weight, or nullptr to pick uniformly.
+	 * @param owner The index that owns the words.
+	 */
+	WordListView(const_iterator first, const_iterator last, const LetterMask* masks, const std::uint32_t* weights,
+	             const float* scores, const AliasTable* sampler, std::shared_ptr<const WordIndex> owner) :
+		first(first), last(last), masks(masks), weights(weights), scores(scores), sampler(sampler),
+		owner(std::move(owner))
+	{
+	}
+
+	/**
+	 * @return An iterator to the first word in the view.
+	 */
+	[[nodiscard]] const_iterator begin() const { return first; }
+
+	/**
+	 * @return An iterator one past the last word in the view.
+	 */
+	[[nodiscard]] const_iterator end() const { return last; }
+
+	/**
+	 * @return The number of words in the view.
+	 */
+	[[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last - first); }
+
+	/**
+	 * @return True if the view contains no words.
+	 */
+	[[nodiscard]] bool empty() const { return first == last; }
+
+	/**
+	 * @brief Retrieves the word at the given position.
+	 *
+	 * @param index Position of the word inside the view. Must be less than size().
+	 * @return The word at the given position.
+	 */
+	[[nodiscard]] std::string_view operator[](std::size_t index) const { return first[index]; }
+
+	/**
+	 * @brief Retrieves the precomputed set of distinct letters of the word at the given position.
+	 *
+	 * @param index Position of the word inside the view. Must be less than size().
+	 * @return The letter mask of the word.
+	 */
+	[[nodiscard]] LetterMask letterMask(std::size_t index) const { return masks[index]; }
+
+	/**
+	 * @brief Retrieves the selection weight of the word at the given position.
+	 *
+	 * @param index Position of the word inside the view. Must be less than size().
+	 * @return The weight from the dictionary's weight column, 1 if it has none.
+	 */
+	[[nodiscard]] std::uint32_t weight(std::size_t index) const { return weights != nullptr ? weights[index] : 1; }
+
+	/**
+	 * @brief Retrieves the difficulty score of the word at the given position.
+	 *
+	 * @param index Position of the word inside the view. Must be less than size().
+	 * @return The score the index computed for the word, see WordIndex::score().
+	 */
+	[[nodiscard]] float score(std::size_t index) const { return scores[index]; }
+
+	/**
+	 * @brief Identifies the word at the given position within its index.
+	 *
+	 * @param index Position of the word inside the view. Must be less than size().
+	 * @return The word's position in the index's length order, see WordIndex::word().
+	 */
+	[[nodiscard]] std::uint32_t wordNumber(std::size_t index) const;
+
+	/**
+	 * @return The index that owns the words, null for an empty default-constructed view.
+	 */
+	[[nodiscard]] const std::shared_ptr<const WordIndex>& index() const { return owner; }
+
+	/**
+	 * @brief Picks a random word position, in proportion to the word weights.
+	 *
+	 * Constant time: views over a difficulty level of a weighted dictionary use
+	 * the alias table built when it was loaded, all other views pick uniformly.
+	 *
+	 * @param random The random engine.
+	 * @return A position less than size(). Must not be called on an empty view.
+	 */
+	[[nodiscard]] std::size_t pick(RandomEngine& random) const
+	{
+		return sampler != nullptr ? sampler->pick(random) : static_cast<std::size_t>(random.below(size()));
+	}
+
+private:
+	/**
+	 * @brief Pointer to the first word of the view.
+	 */
+	const_iterator first{nullptr};
+
+	/**
+	 * @brief Pointer one past the last word of the view.
+	 */
+	const_iterator last{nullptr};
+
+	/**
+	 * @brief Letter masks of the words in the view, in the same order.
+	 */
+	const LetterMask* masks{nullptr};
+
+	/**
+	 * @brief Weights of the words in the view, in the same order, nullptr if unweighted.
+	 */
+	const std::uint32_t* weights{nullptr};
+
+	/**
+	 * @brief Difficulty scores of the words in the view, in the same order.
+	 */
+	const float* scores{nullptr};
+
+	/**
+	 * @brief Picks from the view by weight, nullptr to pick uniformly.
+	 */
+	const AliasTable* sampler{nullptr};
+
+	/**
+	 * @brief Keeps the index (and with it the word storage) alive for the lifetime of the view.
+	 */
+	std::shared_ptr<const WordIndex> owner;
+};
+
+/**
+ * @class WordIndex
+ * @brief An immutable, in-memory dictionary grouped by word length.
+ *
+ * The dictionary file is parsed exactly once. Words are kept in a single array
+ * ordered by length (and by file order within a length), so every length range,
+ * and therefore every difficulty level, is a contiguous slice of that array and
+ * can be handed out as a WordListView without copying. The letter mask of every
+ * word is computed once, when the index is built.
+ *
+ * Every word also gets a difficulty score when the index is built (see
+ * score()). The playable words, those of up to HARD_FILE_MAX_LENGTH letters,
+ * are additionally kept ranked by score, so a difficulty level or any finer
+ * tier is a contiguous slice of that ranking as well.
+ *
+ * Words may carry a selection weight, such as their frequency in a corpus. If
+ * they do, an alias table is built for every difficulty level at load time, so
+ * picking a word by weight takes constant time however large the level is.
+ *
+ * An index can be loaded from a plain text word list or from a compiled
+ * dictionary (see DictionaryFormat.h), which needs no parsing at all, or be
+ * built over a dictionary embedded in the program (see EmbeddedDictionary.h).
+ */
+class WordIndex : public std::enable_shared_from_this<WordIndex>
+{
+public:
+	/**
+	 * @brief Memory-maps and indexes a dictionary file.
+	 *
+	 * Compiled dictionaries are recognized by their magic number and validated.
+	 * Any other file is read as a word list with one word per line. Words are views
+	 * into the mapping. Trailing whitespace, including the carriage return of CRLF
+	 * line endings, is trimmed and empty lines are skipped. A line may end in a
+	 * whitespace separated second column holding the word's weight (see
+	 * splitWeight()); words without one weigh 1.
+	 *
+	 * Word lists larger than PARALLEL_CHUNK_SIZE are split into newline-aligned
+	 * chunks that are parsed on several threads. The result does not depend on
+	 * the number of threads: words of the same length are always in file order.
+	 *
+	 * @param fileToRead Path to the dictionary file.
+	 * @param threads The number of threads parsing a text word list, 0 for one per hardware thread.
+	 * @return The shared, immutable index.
+	 * @throws FileNotFoundException if the specified file cannot be opened.
+	 * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+	 */
+	[[nodiscard]] static std::shared_ptr<const WordIndex> load(const std::filesystem::path& fileToRead,
+	                                                           std::size_t threads = 0);
+
+	/**
+	 * @brief Indexes a dictionary that was compiled into the program.
+	 *
+	 * @param dictionary The generated dictionary tables.
+	 * @return The shared, immutable index.
+	 */
+	[[nodiscard]] static std::shared_ptr<const WordIndex> fromEmbedded(const EmbeddedDictionary& dictionary);
+
+	/**
+	 * @brief Writes the index as a compiled dictionary.
+	 *
+	 * @param fileToWrite Path of the compiled dictionary to create or replace.
+	 * @throws InvalidDictionaryException if the file cannot be written.
+	 */
+	void writeBinary(const std::filesystem::path& fileToWrite) const;
+
+	/**
+	 * @brief Retrieves all words whose length lies in [minLength, maxLength].
+	 *
+	 * @param minLength The minimum word length, inclusive.
+	 * @param maxLength The maximum word length, inclusive.
+	 * @return A view over the matching words, empty if there are none.
+	 */
+	[[nodiscard]] WordListView wordsInRange(std::size_t minLength, std::size_t maxLength) const;
+
+	/**
+	 * @brief Retrieves all words of exactly the given length.
+	 *
+	 * @param length The word length.
+	 * @return A view over the matching words, empty if there are none.
+	 */
+	[[nodiscard]] WordListView wordsOfLength(std::size_t length) const;
+
+	/**
+	 * @brief Retrieves the pattern index of the words of exactly the given length.
+	 *
+	 * Built on first use for every length and kept for the lifetime of the index.
+	 *
+	 * @param length The word length.
+	 * @return The index over the words of wordsOfLength(length), sharing ownership of this index.
+	 */
+	[[nodiscard]] std::shared_ptr<const PatternIndex> patternIndex(std::size_t length) const;
+
+	/**
+	 * @brief Retrieves the words belonging to a difficulty level.
+	 *
+	 * The playable words ranked by score are split into three tiers of equal
+	 * size: WordDifficultyTypes::EASY is the lowest scoring third, MEDIUM the
+	 * middle one and HARD the highest scoring third.
+	 *
+	 * @param difficulty The difficulty level.
+	 * @return A view over the matching words, ordered by score, empty for an unknown difficulty.
+	 */
+	[[nodiscard]] WordListView forDifficulty(WordDifficultyTypes difficulty) const;
+
+	/**
+	 * @brief Retrieves one of several equally sized difficulty tiers of the playable words.
+	 *
+	 * @param tier The tier, 0 for the easiest.
+	 * @param tierCount The number of tiers the words are split into.
+	 * @return A view over the words of the tier, ordered by score, empty if tier is not less than tierCount.
+	 */
+	[[nodiscard]] WordListView forTier(std::size_t tier, std::size_t tierCount) const;
+
+	/**
+	 * @brief Retrieves the playable words whose score lies in [minScore, maxScore].
+	 *
+	 * @param minScore The minimum score, inclusive.
+	 * @param maxScore The maximum score, inclusive.
+	 * @return A view over the matching words, ordered by score, empty if there are none.
+	 */
+	[[nodiscard]] WordListView wordsByScore(float minScore, float maxScore) const;
+
+	/**
+	 * @brief Retrieves the word lengths that used to define a difficulty level.
+	 *
+	 * For consumers that see words one at a time and so cannot score them, such
+	 * as FileManager::sampleWords().
+	 *
+	 * @param difficulty The difficulty level.
+	 * @return The minimum and maximum length, inclusive. The minimum exceeds the maximum for an unknown difficulty.
+	 */
+	[[nodiscard]] static std::pair<std::size_t, std::size_t> lengthRange(WordDifficultyTypes difficulty);
+
+	/**
+	 * @brief Checks whether a character is trimmed from the end of a line.
+	 *
+	 * @param c The character to check.
+	 * @return True for spaces, tabs, carriage returns, vertical tabs and form feeds.
+	 */
+	static constexpr bool isTrailingWhitespace(const char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	/**
+	 * @brief Separates the weight column from a line of a text word list.
+	 *
+	 * A line has a weight column if it ends in a run of decimal digits preceded by
+	 * whitespace and by a word. Weights above the range of std::uint32_t are clamped.
+	 *
+	 * @param line A line without trailing whitespace. Left unchanged if the line
+	 *             has no weight column, otherwise trimmed to the word.
+	 * @return The weight, or no value if the line has no weight column.
+	 */
+	[[nodiscard]] static std::optional<std::uint32_t> splitWeight(std::string_view& line);
+
+	/**
+	 * @return True if the words carry weights, false if they are all picked equally often.
+	 */
+	[[nodiscard]] bool weighted() const { return weights != nullptr; }
+
+	/**
+	 * @return The total number of words in the index.
+	 */
+	[[nodiscard]] std::size_t size() const { return words.size(); }
+
+	/**
+	 * @return The length of the longest word in the index, or 0 if the index is empty.
+	 */
+	[[nodiscard]] std::size_t maxWordLength() const { return lengthOffsets.size() - 2; }
+
+	/**
+	 * @brief Retrieves a word by its position in the length order.
+	 *
+	 * @param number The word number, less than size(), as returned by WordListView::wordNumber().
+	 * @return The word.
+	 */
+	[[nodiscard]] std::string_view word(const std::size_t number) const { return words[number]; }
+
+	/**
+	 * @brief Finds the number of a word handed out by a view of this index.
+	 *
+	 * @param word A pointer into the words of a view of this index.
+	 * @return The word's position in the length order.
+	 */
+	[[nodiscard]] std::uint32_t wordNumber(const std::string_view* word) const;
+
+	/**
+	 * @brief Identifies the word list, so that word numbers can be checked against it.
+	 *
+	 * Computed on first use from every word in length order; indexes of the same
+	 * words in the same order share it however they were loaded.
+	 *
+	 * @return A 32 bit FNV-1a hash of the words.
+	 */
+	[[nodiscard]] std::uint32_t fingerprint() const;
+
+	/**
+	 * @brief Retrieves the difficulty score of a word.
+	 *
+	 * The score estimates how hard the word is to guess, compared with the other
+	 * words of its length: the number of misses a player guessing letters in
+	 * order of their frequency among those words would make before completing it,
+	 * plus RARITY_WEIGHT times the mean rarity of its letters in bits, plus
+	 * DISTINCT_LETTERS_WEIGHT divided by its number of distinct letters, since
+	 * every correct guess of a word with few of them reveals more and leaves
+	 * fewer chances to hit.
+	 *
+	 * @param wordNumber The word number, in length order. Must be less than size().
+	 * @return The score, 0 or more, higher is harder.
+	 */
+	[[nodiscard]] float score(std::size_t wordNumber) const { return scores[wordNumber]; }
+
+	/**
+	 * @brief How much the mean rarity of a word's letters, in bits, adds to its score.
+	 */
+	static constexpr float RARITY_WEIGHT = 0.5F;
+
+	/**
+	 * @brief How much a word with a single distinct letter adds to its score, divided by the number of distinct letters.
+	 */
+	static constexpr float DISTINCT_LETTERS_WEIGHT = 2.0F;
+
+	/**
+	 * @brief The smallest chunk of a text word list parsed by one thread.
+	 */
+	static constexpr std::size_t PARALLEL_CHUNK_SIZE = 4 << 20;
+
+private:
+	/**
+	 * @brief Constructs an empty index. Use load() or fromEmbedded() to create one.
+	 */
+	WordIndex() = default;
+
+	/**
+	 * @brief Indexes the mapped contents of a text word list.
+	 *
+	 * @param threads The number of threads to parse with, at least 1.
+	 */
+	void loadText(std::size_t threads);
+
+	/**
+	 * @brief Validates the mapped contents of a compiled dictionary and indexes it in place.
+	 *
+	 * @param fileToRead Path to the dictionary file, used in error messages.
+	 * @throws InvalidDictionaryException if the file fails validation.
+	 */
+	void loadBinary(const std::filesystem::path& fileToRead);
+
+	/**
+	 * @brief Builds the word views over a string pool grouped into fixed-size records per length.
+	 *
+	 * `lengthOffsets` must already describe the pool.
+	 *
+	 * @param pool The first byte of the string pool.
+	 */
+	void indexPool(const char* pool);
+
+	/**
+	 * @brief Scores every word and ranks the playable words by score.
+	 */
+	void buildRanking();
+
+	/**
+	 * @brief Builds an alias table for every difficulty level of a weighted index.
+	 */
+	void buildSamplers();
+
+	/**
+	 * @brief Builds a view over a slice of the length order or of the ranking.
+	 *
+	 * @param ranked True for the ranking, false for the length order.
+	 * @param first The position of the first word of the slice.
+	 * @param last The position one past the last word of the slice.
+	 * @return The view, picking by weight if an alias table covers exactly the slice.
+	 */
+	[[nodiscard]] WordListView view(bool ranked, std::size_t first, std::size_t last) const;
+
+	/**
+	 * @brief Splits text into trimmed, non-empty lines and separates their weights.
+	 *
+	 * @param contents The text to split.
+	 * @param lineWeights Receives the weight of every word, or stays empty if no line has a weight column.
+	 * @return Views into contents, one per word, in order.
+	 */
+	[[nodiscard]] static std::vector<std::string_view> splitLines(std::string_view contents,
+	                                                              std::vector<std::uint32_t>& lineWeights);
+
+	/**
+	 * @brief Groups the given words by length and stores them in the index.
+	 *
+	 * The relative order of words of the same length is preserved and the letter
+	 * mask of every word is computed.
+	 *
+	 * @param unsortedWords The words in file order.
+	 * @param unsortedWeights The weights of the words in file order, empty if unweighted.
+	 */
+	void buildBuckets(const std::vector<std::string_view>& unsortedWords,
+	                  const std::vector<std::uint32_t>& unsortedWeights);
+
+	/**
+	 * @brief Splits text into chunks of about chunkSize bytes that end at a line break.
+	 *
+	 * @param contents The text to split.
+	 * @param chunkSize The target chunk size.
+	 * @return The chunks, in order, covering all of contents.
+	 */
+	[[nodiscard]] static std::vector<std::string_view> splitChunks(std::string_view contents, std::size_t chunkSize);
+
+	/**
+	 * @brief Splits and groups the words of several chunks of a word list in parallel.
+	 *
+	 * Every chunk is split and its words counted per length on its own; the counts
+	 * give every chunk the position of its words in each bucket, so the words are
+	 * then placed, again in parallel, exactly where buildBuckets() would put them.
+	 *
+	 * @param chunks The chunks of the word list, in file order.
+	 * @param threads The number of threads.
+	 */
+	void buildBucketsParallel(const std::vector<std::string_view>& chunks, std::size_t threads);
+
+	/**
+	 * @brief The mapped dictionary file that all entries in `words` point into.
+	 *
+	 * Empty for an embedded dictionary, whose words point into constant data.
+	 */
+	MappedFile storage;
+
+	/**
+	 * @brief Every word in the dictionary, ordered by length.
+	 */
+	std::vector<std::string_view> words;
+
+	/**
+	 * @brief The letter mask of every word, in the same order as `words`.
+	 *
+	 * Points into `computedMasks`, directly into a compiled dictionary mapping, or
+	 * into the tables of an embedded dictionary.
+	 */
+	const LetterMask* masks{nullptr};
+
+	/**
+	 * @brief Storage for the letter masks of an index built from a text word list.
+	 */
+	std::vector<LetterMask> computedMasks;
+
+	/**
+	 * @brief The weight of every word, in the same order as `words`, or nullptr if unweighted.
+	 *
+	 * Points into `computedWeights`, a compiled dictionary mapping or the tables
+	 * of an embedded dictionary, like `masks`.
+	 */
+	const std::uint32_t* weights{nullptr};
+
+	/**
+	 * @brief Storage for the weights of an index built from a text word list.
+	 */
+	std::vector<std::uint32_t> computedWeights;
+
+	/**
+	 * @brief The difficulty score of every word, in the same order as `words`.
+	 */
+	std::vector<float> scores;
+
+	/**
+	 * @brief The playable words, ordered by score and by length order among equal scores.
+	 */
+	std::vector<std::string_view> rankedWords;
+
+	/**
+	 * @brief The letter masks of `rankedWords`, in the same order.
+	 */
+	std::vector<LetterMask> rankedMasks;
+
+	/**
+	 * @brief The weights of `rankedWords`, in the same order, empty if unweighted.
+	 */
+	std::vector<std::uint32_t> rankedWeights;
+
+	/**
+	 * @brief The scores of `rankedWords`, ascending.
+	 */
+	std::vector<float> rankedScores;
+
+	/**
+	 * @brief The position in `words` of every word of `rankedWords`, in the same order.
+	 */
+	std::vector<std::uint32_t> rankedNumbers;
+
+	/**
+	 * @brief Computes `fingerprintValue` once.
+	 */
+	mutable std::once_flag fingerprintOnce;
+
+	/**
+	 * @brief The value of fingerprint(), valid once `fingerprintOnce` has run.
+	 */
+	mutable std::uint32_t fingerprintValue{0};
+
+	/**
+	 * @brief Guards `patterns`.
+	 */
+	mutable std::mutex patternMutex;
+
+	/**
+	 * @brief The pattern index of every length built so far, indexed by length.
+	 */
+	mutable std::vector<std::unique_ptr<const PatternIndex>> patterns;
+
+	/**
+	 * @brief An alias table over the words [first, last) of the ranking.
+	 */
+	struct RangeSampler
+	{
+		const std::string_view* first;
+		const std::string_view* last;
+		AliasTable table;
+	};
+
+	/**
+	 * @brief The alias tables of the difficulty levels, empty if unweighted.
+	 */
+	std::vector<RangeSampler> samplers;
+
+	/**
+	 * @brief Bucket boundaries: the words of length n occupy [lengthOffsets[n], lengthOffsets[n + 1]).
+	 *
+	 * Always holds at least two entries, so an empty index has a maximum word length of 0.
+	 */
+	std::vector<std::size_t> lengthOffsets{0, 0};
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef WORDRESERVOIR_H
+#define WORDRESERVOIR_H
+
+#include <RandomEngine.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class WordReservoir
+ * @brief Keeps a uniform random sample of a stream of words in bounded memory.
+ *
+ * Words are offered one at a time and at most `capacity` of them are kept, so
+ * a dictionary of any size can be sampled in a single pass. Every k-subset of
+ * the words offered is equally likely to be the sample. The reservoir uses
+ * Li's Algorithm L: instead of drawing a random number per word, it draws how
+ * many words to skip before the next replacement, which makes the random work
+ * logarithmic in the stream length.
+ */
+class WordReservoir
+{
+public:
+	/**
+	 * @brief Constructs an empty reservoir.
+	 *
+	 * @param capacity The number of words to keep.
+	 * @param random The random engine, must outlive the reservoir.
+	 */
+	WordReservoir(std::size_t capacity, RandomEngine& random);
+
+	/**
+	 * @brief Offers the next word of the stream.
+	 *
+	 * @param word The word, copied only if it is kept.
+	 */
+	void offer(std::string_view word);
+
+	/**
+	 * @return The number of words offered so far.
+	 */
+	[[nodiscard]] std::uint64_t offered() const { return count; }
+
+	/**
+	 * @brief Hands out the sample in random order and empties the reservoir.
+	 *
+	 * @return The sampled words, fewer than the capacity if fewer were offered.
+	 */
+	[[nodiscard]] std::vector<std::string> take();
+
+private:
+	/**
+	 * @brief Draws the position of the next word to keep.
+	 */
+	void scheduleNext();
+
+	/**
+	 * @brief The number of words to keep.
+	 */
+	std::size_t capacity;
+
+	/**
+	 * @brief Decides which words are kept.
+	 */
+	RandomEngine& random;
+
+	/**
+	 * @brief The words kept so far.
+	 */
+	std::vector<std::string> samples;
+
+	/**
+	 * @brief The number of words offered so far.
+	 */
+	std::uint64_t count{0};
+
+	/**
+	 * @brief The position in the stream of the next word to keep, once the reservoir is full.
+	 */
+	std::uint64_t next{0};
+
+	/**
+	 * @brief Algorithm L's running maximum of the words' random keys.
+	 */
+	double weight{1.0};
+};
+
+#endif
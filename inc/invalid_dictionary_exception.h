@@ -0,0 +1,42 @@
+#pragma once
+
+#include <exception>
+#include <string>
+
+/**
+ * @class InvalidDictionaryException
+ * @brief Exception thrown when a dictionary file cannot be used.
+ *
+ * This exception is thrown when a compiled dictionary fails validation,
+ * for example because it is truncated, was written by an incompatible
+ * version, or when a dictionary cannot be written out.
+ */
+class InvalidDictionaryException final : public std::exception {
+private:
+    /**
+     * A string variable to store a message.
+     */
+    std::string message;
+
+public:
+    /**
+     * @brief Constructs the exception for a given file and reason.
+     *
+     * @param filename The dictionary file that could not be used.
+     * @param reason A short description of what is wrong with it.
+     */
+    InvalidDictionaryException(const std::string& filename, const std::string& reason)
+        : message("Invalid dictionary " + filename + ": " + reason) {}
+
+    /**
+     * Returns a C-string representing the error message.
+     *
+     * Overrides the `what()` method from the standard exception class to provide
+     * specific details about the exception.
+     *
+     * @return A pointer to a null-terminated string with the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
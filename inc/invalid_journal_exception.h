@@ -0,0 +1,41 @@
+#pragma once
+
+#include <exception>
+#include <string>
+
+/**
+ * @class InvalidJournalException
+ * @brief Exception thrown when a game journal cannot be used.
+ *
+ * This exception is thrown when a file is not a journal of a supported
+ * version, or when a journal cannot be opened for appending.
+ */
+class InvalidJournalException final : public std::exception {
+private:
+    /**
+     * A string variable to store a message.
+     */
+    std::string message;
+
+public:
+    /**
+     * @brief Constructs the exception for a given file and reason.
+     *
+     * @param filename The journal file that could not be used.
+     * @param reason A short description of what is wrong with it.
+     */
+    InvalidJournalException(const std::string& filename, const std::string& reason)
+        : message("Invalid journal " + filename + ": " + reason) {}
+
+    /**
+     * Returns a C-string representing the error message.
+     *
+     * Overrides the `what()` method from the standard exception class to provide
+     * specific details about the exception.
+     *
+     * @return A pointer to a null-terminated string with the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <exception>
+#include <string>
+
+/**
+ * @class PlayerStoreException
+ * @brief Exception thrown when the files of a player store cannot be read or written.
+ *
+ * Damaged data is not an error: an unusable snapshot is ignored and the
+ * unreadable tail of a log is cut off. This exception is reserved for files
+ * that cannot be opened, created or written at all.
+ */
+class PlayerStoreException final : public std::exception {
+private:
+    /**
+     * A string variable to store a message.
+     */
+    std::string message;
+
+public:
+    /**
+     * @brief Constructs the exception for a given file and reason.
+     *
+     * @param filename The file that could not be used.
+     * @param reason A short description of what went wrong.
+     */
+    PlayerStoreException(const std::string& filename, const std::string& reason)
+        : message("Player store " + filename + ": " + reason) {}
+
+    /**
+     * Returns a C-string representing the error message.
+     *
+     * Overrides the `what()` method from the standard exception class to provide
+     * specific details about the exception.
+     *
+     * @return A pointer to a null-terminated string with the error message.
+     */
+    [[nodiscard]] const char* what() const noexcept override {
+        return message.c_str();
+    }
+};
@@ -23,12 +23,68 @@ enum class WordDifficultyTypes {
     HARD = 3
 };
 
+/**
+ * @enum GuessResult
+ * @brief The outcome of applying a guessed letter to a game.
+ *
+ * - CORRECT: The letter is in the word and was revealed.
+ * - INCORRECT: The letter is not in the word and cost an attempt.
+ * - ALREADY_GUESSED: The letter was already guessed correctly, nothing changed.
+ * - ALREADY_GUESSED_INCORRECTLY: The letter was already guessed incorrectly, nothing changed.
+ * - NOT_A_LETTER: The character is not a letter from a to z, nothing changed.
+ * - TIMED_OUT: No letter was guessed in time, which cost an attempt.
+ * - GAME_OVER: The game has already been won or lost, or was never started, nothing changed.
+ */
+enum class GuessResult {
+    CORRECT,
+    INCORRECT,
+    ALREADY_GUESSED,
+    ALREADY_GUESSED_INCORRECTLY,
+    NOT_A_LETTER,
+    TIMED_OUT,
+    GAME_OVER
+};
+
+/**
+ * @enum GameStatus
+ * @brief The state of a single game.
+ *
+ * - NOT_STARTED: No word has been chosen yet.
+ * - IN_PROGRESS: The word is being guessed.
+ * - WON: Every letter of the word was guessed.
+ * - LOST: The attempts ran out before the word was guessed.
+ */
+enum class GameStatus {
+    NOT_STARTED,
+    IN_PROGRESS,
+    WON,
+    LOST
+};
+
+/**
+ * @enum TurnState
+ * @brief What the console game is waiting for from the player.
+ *
+ * - NAME: The player's name.
+ * - DIFFICULTY: The difficulty of the next game, 1 to 3.
+ * - GUESS: A letter to guess, or '?' for a hint.
+ * - PLAY_AGAIN: Whether to play another game.
+ * - FINISHED: Nothing, the player has left.
+ */
+enum class TurnState {
+    NAME,
+    DIFFICULTY,
+    GUESS,
+    PLAY_AGAIN,
+    FINISHED
+};
+
 /**
  * @brief Defines the maximum length for words in the 'EASY' difficulty category.
  *
  * This constant is used to filter words based on their length when classifying them
- * as 'EASY' in the context of word difficulty levels. Only words whose length is
- * less than or equal to this value are considered 'EASY'.
+ * as 'EASY' where words cannot be scored, such as when streaming a word list.
+ * Only words whose length is less than or equal to this value are then considered 'EASY'.
  *
  * @see WordDifficultyTypes::EASY
  */
@@ -48,7 +104,8 @@ constexpr unsigned long MEDIUM_FILE_MAX_LENGTH = 7;
  *
  * This constant defines the upper bound on the length of words that are
  * considered to be of "HARD" difficulty. Any word with a length greater
- * than this value will not be classified as "HARD".
+ * than this value will not be classified as "HARD", and is left out of the
+ * difficulty levels ranked by score altogether.
  *
  * @ingroup Config
  */
@@ -82,6 +139,14 @@ constexpr int MAX_NUMBER_TRIES = 6;
  */
 constexpr int MAX_NUMBER_WORDS_READ = 250;
 
+/**
+ * @brief File extension of a compiled dictionary.
+ *
+ * The build compiles data/dictionary.txt into dictionary.bin next to it, and FileManager
+ * loads the compiled file in place of a text word list with the same name when present.
+ */
+constexpr const char* COMPILED_DICTIONARY_EXTENSION = ".bin";
+
 
 
 
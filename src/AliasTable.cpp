@@ -0,0 +1,53 @@
+#include <AliasTable.h>
+
+#include <limits>
+
+/**
+ * Builds the table with Vose's method: every weight is scaled so that the
+ * average is 1, then each column under 1 is topped up from one over 1 until
+ * every column holds exactly 1. Entries left over by rounding are full.
+ *
+ * @param weights The weight of every entry.
+ * @param count The number of entries.
+ */
+AliasTable::AliasTable(const std::uint32_t* weights, const std::size_t count) :
+	thresholds(count, std::numeric_limits<std::uint64_t>::max()), aliases(count)
+{
+	double total = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		total += weights[i];
+		aliases[i] = static_cast<std::uint32_t>(i);
+	}
+	if (total == 0)
+	{
+		return; // every column full, a uniform pick
+	}
+
+	std::vector<double> scaled(count);
+	std::vector<std::uint32_t> small;
+	std::vector<std::uint32_t> large;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		scaled[i] = weights[i] * static_cast<double>(count) / total;
+		(scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+	}
+
+	while (!small.empty() && !large.empty())
+	{
+		const std::uint32_t less = small.back();
+		const std::uint32_t more = large.back();
+		small.pop_back();
+
+		// 2^64 * scaled, which is below 1 here
+		thresholds[less] = static_cast<std::uint64_t>(scaled[less] * 0x1.0p64);
+		aliases[less] = more;
+
+		scaled[more] -= 1.0 - scaled[less];
+		if (scaled[more] < 1.0)
+		{
+			large.pop_back();
+			small.push_back(more);
+		}
+	}
+}
@@ -0,0 +1,305 @@
+#include <ConsoleHost.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/**
+	 * @brief The most output written at a time, PIPE_BUF where a pipe reported writable takes that much without blocking.
+	 */
+#ifdef _WIN32
+	constexpr std::size_t WRITE_SIZE = 4096;
+#else
+	constexpr std::size_t WRITE_SIZE = PIPE_BUF;
+#endif
+
+	/**
+	 * Reads from a descriptor.
+	 *
+	 * @param fd The descriptor.
+	 * @param buffer Receives the bytes.
+	 * @param size The size of the buffer.
+	 * @return The number of bytes read, 0 at the end of the input, negative on an error.
+	 */
+	std::ptrdiff_t readSome(const int fd, char* buffer, const std::size_t size)
+	{
+#ifdef _WIN32
+		return ::_read(fd, buffer, static_cast<unsigned>(size));
+#else
+		return ::read(fd, buffer, size);
+#endif
+	}
+
+	/**
+	 * Writes to a descriptor.
+	 *
+	 * @param fd The descriptor.
+	 * @param data The bytes.
+	 * @param size The number of bytes.
+	 * @return The number of bytes written, negative on an error.
+	 */
+	std::ptrdiff_t writeSome(const int fd, const char* data, const std::size_t size)
+	{
+#ifdef _WIN32
+		return ::_write(fd, data, static_cast<unsigned>(size));
+#else
+		return ::write(fd, data, size);
+#endif
+	}
+}
+
+/**
+ * Constructs a session for a pair of descriptors, its game writing to the session's buffer.
+ *
+ * @param inputFd The descriptor input is read from.
+ * @param outputFd The descriptor output is written to.
+ */
+ConsoleHost::Session::Session(const int inputFd, const int outputFd)
+	: inputFd(inputFd), outputFd(outputFd), game(output)
+{
+}
+
+/**
+ * Constructs a host without games.
+ *
+ * @param turnTimeout The time a player has for every answer, 0 for no limit.
+ */
+ConsoleHost::ConsoleHost(const std::chrono::milliseconds turnTimeout) : turnTimeout(turnTimeout)
+{
+}
+
+/**
+ * Adds a game, started by the next run().
+ *
+ * @param inputFd The descriptor the player's input is read from.
+ * @param outputFd The descriptor the game is written to.
+ * @return The game.
+ */
+GameManager& ConsoleHost::add(const int inputFd, const int outputFd)
+{
+	sessions.push_back(std::make_unique<Session>(inputFd, outputFd));
+	return sessions.back()->game;
+}
+
+#ifdef _WIN32
+/**
+ * Plays the games one after another with blocking reads and writes. Windows
+ * has no poll() for console handles and pipes, so turns are not timed.
+ */
+void ConsoleHost::run()
+{
+	for (const auto& session : sessions)
+	{
+		session->started = true;
+		session->game.begin();
+		collectOutput(*session);
+		while (session->game.turnState() != TurnState::FINISHED || !session->pending.empty())
+		{
+			if (!session->pending.empty())
+			{
+				writeOutput(*session);
+			}
+			else if (session->inputOpen)
+			{
+				readInput(*session);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+	sessions.clear();
+}
+#else
+/**
+ * Plays every game until it finishes and its output is written. Every round
+ * waits in poll() for input, room for output or the earliest turn deadline,
+ * whichever comes first, then handles what is ready and the expired turns.
+ */
+void ConsoleHost::run()
+{
+	const bool timed = turnTimeout > std::chrono::milliseconds::zero();
+	std::vector<pollfd> descriptors;
+	std::vector<Session*> owners;
+
+	while (!sessions.empty())
+	{
+		auto now = std::chrono::steady_clock::now();
+		auto wakeUp = std::chrono::steady_clock::time_point::max();
+		descriptors.clear();
+		owners.clear();
+		for (const auto& session : sessions)
+		{
+			if (!session->started)
+			{
+				session->started = true;
+				session->deadline = now + turnTimeout;
+				session->game.begin();
+				collectOutput(*session);
+			}
+			if (session->inputOpen && session->game.turnState() != TurnState::FINISHED)
+			{
+				descriptors.push_back({session->inputFd, POLLIN, 0});
+				owners.push_back(session.get());
+				wakeUp = timed ? std::min(wakeUp, session->deadline) : wakeUp;
+			}
+			if (!session->pending.empty())
+			{
+				descriptors.push_back({session->outputFd, POLLOUT, 0});
+				owners.push_back(session.get());
+			}
+		}
+
+		int timeout = -1;
+		if (wakeUp != std::chrono::steady_clock::time_point::max())
+		{
+			// Round up, waking a millisecond early would only spin until the deadline
+			const auto left = std::max(wakeUp - now, std::chrono::steady_clock::duration::zero());
+			const auto wait = std::chrono::ceil<std::chrono::milliseconds>(left);
+			timeout = static_cast<int>(std::min<std::chrono::milliseconds::rep>(wait.count(), INT_MAX));
+		}
+		if (::poll(descriptors.data(), descriptors.size(), timeout) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throw std::system_error(errno, std::generic_category(), "poll");
+		}
+
+		for (std::size_t i = 0; i < descriptors.size(); ++i)
+		{
+			if (descriptors[i].revents == 0)
+			{
+				continue;
+			}
+			if (descriptors[i].events == POLLIN)
+			{
+				readInput(*owners[i]);
+			}
+			else
+			{
+				writeOutput(*owners[i]);
+			}
+		}
+
+		if (timed)
+		{
+			now = std::chrono::steady_clock::now();
+			for (const auto& session : sessions)
+			{
+				if (session->inputOpen && session->game.turnState() != TurnState::FINISHED && session->deadline <= now)
+				{
+					session->game.timeOut();
+					session->deadline = now + turnTimeout;
+					collectOutput(*session);
+				}
+			}
+		}
+
+		sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+		                              [](const std::unique_ptr<Session>& session) {
+			                              return session->game.turnState() == TurnState::FINISHED &&
+			                                     session->pending.empty();
+		                              }),
+		               sessions.end());
+	}
+}
+#endif
+
+/**
+ * Reads the available input of a session and lets its game consume it. Every
+ * answer taken starts the time for the next one.
+ *
+ * @param session The session.
+ */
+void ConsoleHost::readInput(Session& session) const
+{
+	char buffer[READ_SIZE];
+	const std::ptrdiff_t count = readSome(session.inputFd, buffer, sizeof(buffer));
+	if (count < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+	{
+		return;
+	}
+	if (count <= 0)
+	{
+		closeInput(session);
+		return;
+	}
+
+	session.input.append(buffer, static_cast<std::size_t>(count));
+	const std::size_t consumed = session.game.consume(session.input);
+	session.input.erase(0, consumed);
+	if (consumed > 0)
+	{
+		session.deadline = std::chrono::steady_clock::now() + turnTimeout;
+	}
+	collectOutput(session);
+}
+
+/**
+ * Writes up to WRITE_SIZE bytes of pending output, which a pipe reported
+ * writable takes without blocking. A failed write finishes the game, nobody
+ * is watching it any more.
+ *
+ * @param session The session.
+ */
+void ConsoleHost::writeOutput(Session& session)
+{
+	const std::size_t length = std::min(session.pending.size(), WRITE_SIZE);
+	const std::ptrdiff_t written = writeSome(session.outputFd, session.pending.data(), length);
+	if (written < 0)
+	{
+		if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+		{
+			return;
+		}
+		if (session.inputOpen)
+		{
+			closeInput(session);
+		}
+		session.pending.clear();
+		return;
+	}
+	session.pending.erase(0, static_cast<std::size_t>(written));
+}
+
+/**
+ * Moves what the game wrote to the pending output.
+ *
+ * @param session The session.
+ */
+void ConsoleHost::collectOutput(Session& session)
+{
+	std::string text = session.output.str();
+	if (!text.empty())
+	{
+		session.pending += text;
+		session.output.str(std::string());
+	}
+}
+
+/**
+ * Lets the game use the rest of the input and finish.
+ *
+ * @param session The session.
+ */
+void ConsoleHost::closeInput(Session& session)
+{
+	session.inputOpen = false;
+	session.game.consume(session.input, true);
+	session.input.clear();
+	collectOutput(session);
+}
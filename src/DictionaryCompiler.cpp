@@ -0,0 +1,142 @@
+#include <WordIndex.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * Writes a character inside a C++ string literal, escaping it when needed.
+ *
+ * Octal escapes always use three digits, so they can never absorb the
+ * character that follows them.
+ *
+ * @param out The stream to write to.
+ * @param c The character to write.
+ */
+static void writeLiteralChar(std::ostream& out, const char c)
+{
+  const auto byte = static_cast<unsigned char>(c);
+  if (c == '"' || c == '\\') {
+    out << '\\' << c;
+  } else if (byte >= 0x20 && byte < 0x7f) {
+    out << c;
+  } else {
+    out << '\\' << static_cast<char>('0' + (byte >> 6)) << static_cast<char>('0' + ((byte >> 3) & 7))
+        << static_cast<char>('0' + (byte & 7));
+  }
+}
+
+/**
+ * Writes an index as a C++ source file defining EMBEDDED_DICTIONARY.
+ *
+ * The generated tables are constexpr and follow the compiled dictionary layout:
+ * length offsets, one letter mask per word, one weight per word if the word
+ * list has a weight column, and a string pool bucketed by length.
+ *
+ * @param index The index to embed.
+ * @param source Name of the word list the index was built from, for the header comment.
+ * @param fileToWrite Path of the C++ source file to create or replace.
+ * @return True if the file was written successfully.
+ */
+static bool writeEmbeddedSource(const WordIndex& index, const std::string& source, const char* fileToWrite)
+{
+  std::ofstream out(fileToWrite, std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+
+  const WordListView words = index.wordsInRange(0, index.maxWordLength());
+
+  out << "// Generated by hangman_dictc from " << source << ". Do not edit.\n"
+      << "#include <EmbeddedDictionary.h>\n\n"
+      << "namespace {\n\n";
+
+  out << "constexpr std::uint64_t LENGTH_OFFSETS[] = {";
+  std::size_t offset = 0;
+  for (std::size_t length = 0; length <= index.maxWordLength() + 1; ++length) {
+    out << (length % 8 == 0 ? "\n    " : " ") << offset << "u,";
+    offset += index.wordsOfLength(length).size();
+  }
+  out << "\n};\n\n";
+
+  out << "constexpr LetterMask MASKS[] = {";
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    out << (i % 8 == 0 ? "\n    " : " ") << words.letterMask(i) << "u,";
+  }
+  // Arrays cannot be empty, keep a placeholder for an empty dictionary
+  out << (words.empty() ? "\n    0u,\n};\n\n" : "\n};\n\n");
+
+  if (index.weighted()) {
+    out << "constexpr std::uint32_t WEIGHTS[] = {";
+    for (std::size_t i = 0; i < words.size(); ++i) {
+      out << (i % 8 == 0 ? "\n    " : " ") << words.weight(i) << "u,";
+    }
+    out << "\n};\n\n";
+  }
+
+  out << "constexpr char POOL[] =\n    \"";
+  std::size_t column = 0;
+  for (const auto word : words) {
+    for (const char c : word) {
+      writeLiteralChar(out, c);
+    }
+    column += word.size();
+    if (column >= 96) {
+      out << "\"\n    \"";
+      column = 0;
+    }
+  }
+  out << "\";\n\n"
+      << "} // namespace\n\n"
+      << "const EmbeddedDictionary EMBEDDED_DICTIONARY{\n"
+      << "    std::string_view(POOL, sizeof(POOL) - 1),\n"
+      << "    LENGTH_OFFSETS,\n"
+      << "    sizeof(LENGTH_OFFSETS) / sizeof(LENGTH_OFFSETS[0]),\n"
+      << "    MASKS,\n"
+      << (index.weighted() ? "    WEIGHTS,\n" : "    nullptr,\n")
+      << "};\n";
+
+  out.close();
+  return static_cast<bool>(out);
+}
+
+/**
+ * Converts a text word list into a compiled dictionary, or into C++ source
+ * that embeds the dictionary in the program.
+ *
+ * Usage: hangman_dictc [--cpp] <input.txt> <output>
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return EXIT_SUCCESS if the output was written, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+  const bool embed = argc == 4 && std::strcmp(argv[1], "--cpp") == 0;
+  if (argc != 3 && !embed) {
+    std::cerr << "Usage: " << argv[0] << " [--cpp] <input.txt> <output>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* input = argv[argc - 2];
+  const char* output = argv[argc - 1];
+
+  try {
+    const auto index = WordIndex::load(input);
+    if (embed) {
+      if (!writeEmbeddedSource(*index, std::filesystem::path(input).filename().string(), output)) {
+        std::cerr << "Could not write " << output << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else {
+      index->writeBinary(output);
+    }
+    std::cout << "Compiled " << index->size() << " words into " << output << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
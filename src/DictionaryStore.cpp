@@ -0,0 +1,249 @@
+#include <DictionaryStore.h>
+#include <Metrics.h>
+
+#include <array>
+#include <cerrno>
+#include <exception>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Loads a dictionary file, or its up to date compiled sibling.
+ *
+ * @param fileToRead The word list.
+ */
+DictionaryStore::DictionaryStore(std::filesystem::path fileToRead) : file(std::move(fileToRead))
+{
+	reload();
+}
+
+/**
+ * Wraps an index that is not backed by a file.
+ *
+ * @param index The index, published forever.
+ */
+DictionaryStore::DictionaryStore(std::shared_ptr<const WordIndex> index) : current(std::move(index)), published(1)
+{
+}
+
+/**
+ * Stops the watcher thread before the store goes away.
+ */
+DictionaryStore::~DictionaryStore()
+{
+	stopWatching();
+}
+
+/**
+ * Retrieves the current index with an atomic load of the published pointer.
+ *
+ * @return The current snapshot.
+ */
+std::shared_ptr<const WordIndex> DictionaryStore::snapshot() const
+{
+	return std::atomic_load(&current);
+}
+
+/**
+ * Builds the new index without holding anything readers need, then publishes it
+ * with an atomic store. The previous index lives on in the snapshots still held.
+ */
+void DictionaryStore::reload()
+{
+	if (file.empty())
+	{
+		return;
+	}
+
+	const std::lock_guard<std::mutex> lock(reloadMutex);
+	std::shared_ptr<const WordIndex> index;
+	{
+		const ScopedTimer timer(MetricHistogram::DICTIONARY_LOAD);
+		index = WordIndex::load(resolve(file));
+	}
+	Metrics::increment(MetricCounter::DICTIONARY_LOADS);
+	std::atomic_store(&current, std::move(index));
+	published.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Picks the compiled sibling with the extension COMPILED_DICTIONARY_EXTENSION if
+ * it exists and is at least as new as the text file, otherwise the requested
+ * file itself.
+ *
+ * @param fileToRead The requested dictionary file.
+ * @return The file that should be loaded.
+ */
+std::filesystem::path DictionaryStore::resolve(const std::filesystem::path& fileToRead)
+{
+	if (fileToRead.extension() == COMPILED_DICTIONARY_EXTENSION)
+	{
+		return fileToRead;
+	}
+
+	std::filesystem::path compiled = fileToRead;
+	compiled.replace_extension(COMPILED_DICTIONARY_EXTENSION);
+
+	std::error_code ec;
+	const auto compiledTime = std::filesystem::last_write_time(compiled, ec);
+	if (ec)
+	{
+		return fileToRead;
+	}
+	const auto textTime = std::filesystem::last_write_time(fileToRead, ec);
+	if (!ec && textTime > compiledTime)
+	{
+		return fileToRead; // stale, the word list changed after it was compiled
+	}
+	return compiled;
+}
+
+#ifdef __linux__
+
+/**
+ * Watches the directory of the file rather than the file itself, so that
+ * editors and deploy scripts that replace the file by renaming a new one over
+ * it are noticed too.
+ */
+void DictionaryStore::watch()
+{
+	if (file.empty() || watcher.joinable())
+	{
+		return;
+	}
+
+	inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+	{
+		throw std::system_error(errno, std::generic_category(), "inotify_init1");
+	}
+	stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	const std::filesystem::path directory = file.has_parent_path() ? file.parent_path() : ".";
+	if (stopFd < 0 || ::inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		const int error = errno;
+		::close(inotifyFd);
+		if (stopFd >= 0)
+		{
+			::close(stopFd);
+		}
+		inotifyFd = stopFd = -1;
+		throw std::system_error(error, std::generic_category(), "inotify_add_watch " + directory.string());
+	}
+
+	watcher = std::thread([this] { watchLoop(); });
+}
+
+/**
+ * Wakes the watcher through its eventfd and joins it.
+ */
+void DictionaryStore::stopWatching()
+{
+	if (!watcher.joinable())
+	{
+		return;
+	}
+
+	const std::uint64_t one = 1;
+	[[maybe_unused]] const auto ignored = ::write(stopFd, &one, sizeof(one));
+	watcher.join();
+	::close(inotifyFd);
+	::close(stopFd);
+	inotifyFd = stopFd = -1;
+}
+
+/**
+ * Collects change events for the file and its compiled sibling and reloads once
+ * no further event arrived for WATCH_SETTLE_TIME_MS.
+ */
+void DictionaryStore::watchLoop()
+{
+	std::filesystem::path compiled = file;
+	compiled.replace_extension(COMPILED_DICTIONARY_EXTENSION);
+	const std::string textName = file.filename().string();
+	const std::string compiledName = compiled.filename().string();
+
+	alignas(inotify_event) std::array<char, 4096> events{};
+	bool changed = false;
+	for (;;)
+	{
+		pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+		const int ready = ::poll(fds, 2, changed ? WATCH_SETTLE_TIME_MS : -1);
+		if (ready < 0 && errno != EINTR)
+		{
+			return;
+		}
+		if (fds[1].revents != 0)
+		{
+			return;
+		}
+
+		if (ready == 0)
+		{
+			changed = false;
+			try
+			{
+				reload();
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Dictionary reload failed, keeping the current one: " << e.what() << std::endl;
+			}
+			continue;
+		}
+
+		if ((fds[0].revents & POLLIN) != 0)
+		{
+			for (ssize_t length; (length = ::read(inotifyFd, events.data(), events.size())) > 0;)
+			{
+				for (ssize_t offset = 0; offset < length;)
+				{
+					const auto* event = reinterpret_cast<const inotify_event*>(events.data() + offset);
+					if (event->len > 0 && (textName == event->name || compiledName == event->name))
+					{
+						changed = true;
+					}
+					offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+				}
+			}
+		}
+	}
+}
+
+#else
+
+/**
+ * Watching needs inotify, which only Linux provides. Call reload() instead.
+ */
+void DictionaryStore::watch()
+{
+	if (!file.empty())
+	{
+		throw std::system_error(std::make_error_code(std::errc::function_not_supported), "DictionaryStore::watch");
+	}
+}
+
+/**
+ * There is no watcher to stop.
+ */
+void DictionaryStore::stopWatching()
+{
+}
+
+/**
+ * Not used without inotify.
+ */
+void DictionaryStore::watchLoop()
+{
+}
+
+#endif
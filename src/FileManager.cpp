@@ -1,63 +1,213 @@
 #include <FileManager.h>
-#include <fstream>
 #include <string>
 #include <vector>
 #include <file_not_found_exception.h>
-#include <iostream>
+#include <Trace.h>
+#include <WordReservoir.h>
+#include <fstream>
+
+std::map<std::filesystem::path, std::shared_ptr<DictionaryStore>> FileManager::indexCache;
+std::mutex FileManager::indexCacheMutex;
 
 /**
  * Retrieves a list of words from a specified file filtered by the given difficulty level.
  *
  * @param difficulty The difficulty level used to filter the words. It can be one of the following:
- *        - WordDifficultyTypes::EASY: Only includes words with a length up to EASY_FILE_MAX_LENGTH.
- *        - WordDifficultyTypes::MEDIUM: Includes words with a length greater than EASY_FILE_MAX_LENGTH
- *										 and up to MEDIUM_FILE_MAX_LENGTH.
- *        - WordDifficultyTypes::HARD: Includes words with a length greater than MEDIUM_FILE_MAX_LENGTH
- *									   and up to HARD_FILE_MAX_LENGTH.
- * @param fileToRead The file path from which the words are read.
+ *        - WordDifficultyTypes::EASY: The lowest scoring third of the words.
+ *        - WordDifficultyTypes::MEDIUM: The middle third of the words.
+ *        - WordDifficultyTypes::HARD: The highest scoring third of the words.
+ *        Only words of up to HARD_FILE_MAX_LENGTH letters are included, see WordIndex::forDifficulty().
+ * @param fileToRead The file path from which the words are read, empty for the default dictionary.
  *
- * @return A vector containing words that match the specified difficulty level.
+ * @return A view over the words that match the specified difficulty level.
  *
  * @throws FileNotFoundException if the specified file cannot be opened.
  */
-std::vector<std::string> FileManager::getWordList(WordDifficultyTypes difficulty,
-                                                  const std::filesystem::path &fileToRead) const
+WordListView FileManager::getWordList(WordDifficultyTypes difficulty,
+                                      const std::filesystem::path &fileToRead) const
+{
+	HANGMAN_TRACE_SCOPE("getWordList");
+	return getIndex(fileToRead)->forDifficulty(difficulty);
+}
+
+/**
+ * Retrieves a list of words from a specified file whose length lies in [minLength, maxLength].
+ *
+ * @param minLength The minimum word length, inclusive.
+ * @param maxLength The maximum word length, inclusive.
+ * @param fileToRead The file path from which the words are read, empty for the default dictionary.
+ *
+ * @return A view over the words within the length range.
+ *
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ */
+WordListView FileManager::getWordList(const std::size_t minLength, const std::size_t maxLength,
+                                      const std::filesystem::path &fileToRead) const
+{
+	HANGMAN_TRACE_SCOPE("getWordList");
+	return getIndex(fileToRead)->wordsInRange(minLength, maxLength);
+}
+
+/**
+ * Retrieves the current index of a dictionary file, parsing the file only the
+ * first time it is requested by any FileManager in the process. A compiled
+ * dictionary next to the requested file is loaded in its place when it is up to date.
+ *
+ * @param fileToRead The file path from which the words are read. An empty path selects
+ *                   the embedded dictionary when there is one, otherwise `filename`.
+ *
+ * @return The current snapshot of the index for the file.
+ *
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+ */
+std::shared_ptr<const WordIndex> FileManager::getIndex(const std::filesystem::path &fileToRead) const
 {
-	std::ifstream file(fileToRead);
-	std::vector<std::string> wordList;
+	return getStore(fileToRead)->snapshot();
+}
 
-	// Ensure the file is successfully opened
-	if (!file.is_open()) {
-		throw FileNotFoundException(fileToRead.string());  // Corrected to use fileToRead
+/**
+ * Retrieves the store of a dictionary file, creating it the first time the file
+ * is requested by any FileManager in the process.
+ *
+ * @param fileToRead The file path from which the words are read. An empty path selects
+ *                   the embedded dictionary when there is one, otherwise `filename`.
+ *
+ * @return The shared store for the file.
+ *
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+ */
+std::shared_ptr<DictionaryStore> FileManager::getStore(const std::filesystem::path &fileToRead) const
+{
+	if (fileToRead.empty())
+	{
+#ifdef HANGMAN_EMBED_DICTIONARY
+		// Served from constant data, the filesystem is never touched
+		static const std::shared_ptr<DictionaryStore> embeddedStore =
+			std::make_shared<DictionaryStore>(WordIndex::fromEmbedded(EMBEDDED_DICTIONARY));
+		return embeddedStore;
+#else
+		return getStore(filename);
+#endif
 	}
 
-	// Lambda function to determine if a word should be included based on the difficulty level
-	auto shouldIncludeWord = [difficulty](const std::string& word) -> bool {
-		size_t wordLength = word.length();
-		switch (difficulty) {
-		case WordDifficultyTypes::EASY:
-			return wordLength <= EASY_FILE_MAX_LENGTH;
-		case WordDifficultyTypes::MEDIUM:
-			return wordLength > EASY_FILE_MAX_LENGTH && wordLength <= MEDIUM_FILE_MAX_LENGTH;
-		case WordDifficultyTypes::HARD:
-			return wordLength > MEDIUM_FILE_MAX_LENGTH && wordLength <= HARD_FILE_MAX_LENGTH;
-		default:
-			return false;  // Default case, should never happen if difficulty is properly validated
+	std::error_code ec;
+	std::filesystem::path key = std::filesystem::weakly_canonical(fileToRead, ec);
+	if (ec)
+	{
+		key = fileToRead.lexically_normal();
+	}
+
+	const std::lock_guard<std::mutex> lock(indexCacheMutex);
+	auto& store = indexCache[key];
+	if (!store)
+	{
+		store = std::make_shared<DictionaryStore>(fileToRead);
+	}
+	return store;
+}
+
+/**
+ * Picks random words of a difficulty level in a single streaming pass. Words
+ * cannot be scored without the whole dictionary, so the level's length range
+ * from WordIndex::lengthRange() stands in for it.
+ *
+ * @param difficulty The difficulty level of the words to pick.
+ * @param count The number of words to pick.
+ * @param random The random engine that picks the words.
+ * @param fileToRead The text word list, empty for the default dictionary.
+ *
+ * @return The picked words in random order.
+ *
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ */
+std::vector<std::string> FileManager::sampleWords(const WordDifficultyTypes difficulty, const std::size_t count,
+                                                  RandomEngine& random, const std::filesystem::path &fileToRead) const
+{
+	const auto [minLength, maxLength] = WordIndex::lengthRange(difficulty);
+	return sampleWords(minLength, maxLength, count, random, fileToRead);
+}
+
+/**
+ * Picks random words whose length lies in [minLength, maxLength]. The file is
+ * read in fixed-size chunks; a line that straddles two chunks is the only text
+ * ever copied besides the sampled words. Lines are trimmed and stripped of their
+ * weight column like WordIndex does; the weights themselves play no part here.
+ *
+ * @param minLength The minimum word length, inclusive.
+ * @param maxLength The maximum word length, inclusive.
+ * @param count The number of words to pick.
+ * @param random The random engine that picks the words.
+ * @param fileToRead The text word list, empty for the default dictionary.
+ *
+ * @return The picked words in random order.
+ *
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ */
+std::vector<std::string> FileManager::sampleWords(const std::size_t minLength, const std::size_t maxLength,
+                                                  const std::size_t count, RandomEngine& random,
+                                                  const std::filesystem::path &fileToRead) const
+{
+	WordReservoir reservoir(count, random);
+	const auto offer = [&](std::string_view line)
+	{
+		while (!line.empty() && WordIndex::isTrailingWhitespace(line.back()))
+		{
+			line.remove_suffix(1);
+		}
+		[[maybe_unused]] const auto weight = WordIndex::splitWeight(line);
+		if (!line.empty() && line.size() >= minLength && line.size() <= maxLength)
+		{
+			reservoir.offer(line);
 		}
 	};
 
-	// Read words from the file and filter them based on difficulty
-	for (std::string word; std::getline(file, word);) {
-		if (shouldIncludeWord(word)) {
-			wordList.push_back(word);
+#ifdef HANGMAN_EMBED_DICTIONARY
+	if (fileToRead.empty())
+	{
+		// Already in memory, sampling it needs no file
+		const WordListView words = getIndex()->wordsInRange(minLength, maxLength);
+		for (std::size_t i = 0; i < words.size(); ++i)
+		{
+			reservoir.offer(words[i]);
 		}
+		return reservoir.take();
 	}
+#endif
 
-	file.close();
-
-	std::cout << "word list size " << wordList.size() << std::endl;
+	const std::filesystem::path& path = fileToRead.empty() ? filename : fileToRead;
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		throw FileNotFoundException(path.string());
+	}
 
-	return wordList;
-}
+	std::vector<char> buffer(STREAM_BUFFER_SIZE);
+	std::string carry;
+	while (file)
+	{
+		file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		const std::string_view chunk(buffer.data(), static_cast<std::size_t>(file.gcount()));
 
+		std::size_t start = 0;
+		for (std::size_t end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n', start))
+		{
+			if (carry.empty())
+			{
+				offer(chunk.substr(start, end - start));
+			}
+			else
+			{
+				carry.append(chunk.substr(start, end - start));
+				offer(carry);
+				carry.clear();
+			}
+			start = end + 1;
+		}
+		carry.append(chunk.substr(start));
+	}
+	offer(carry);
 
+	return reservoir.take();
+}
@@ -0,0 +1,90 @@
+#include <FrameRenderer.h>
+
+#include <algorithm>
+#include <charconv>
+
+/**
+ * Renders the current state of a game into the frame buffer.
+ *
+ * @param game The game to render.
+ * @return The frame, valid until the next call.
+ */
+std::string_view FrameRenderer::render(const GameEngine& game)
+{
+	updateWordLine(game);
+
+	// Attempts lost to a timeout add no incorrect letter, so count the attempts used
+	const auto misses = static_cast<std::size_t>(std::clamp(MAX_NUMBER_TRIES - game.attemptsLeft(), 0, MAX_NUMBER_TRIES));
+	frame.assign(GALLOWS_FRAMES[misses]);
+
+	char digits[16];
+	const auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), game.attemptsLeft());
+	frame += "Attempts Left: ";
+	frame.append(digits, end);
+	frame += '\n';
+
+	frame += wordLine;
+	frame += "\nIncorrect Guessed Letters: ";
+	appendLetters(game.incorrectLetters(), frame);
+	frame += "\nGuessed Letters: ";
+	appendLetters(game.guessedLetters(), frame);
+	frame += '\n';
+	return frame;
+}
+
+/**
+ * Rebuilds the word line for a new word, otherwise only reveals the cells of
+ * the letters guessed since the last frame.
+ *
+ * @param game The game to render.
+ */
+void FrameRenderer::updateWordLine(const GameEngine& game)
+{
+	const std::string& word = game.targetWord();
+	const LetterMask guessed = game.guessedLetters();
+
+	if (word != renderedWord || (renderedLetters & ~guessed) != 0)
+	{
+		renderedWord = word;
+		wordLine.assign(2 * word.size(), ' ');
+		const std::string& masked = game.maskedWord();
+		for (std::size_t i = 0; i < masked.size(); ++i)
+		{
+			wordLine[2 * i] = masked[i];
+		}
+		renderedLetters = guessed;
+		return;
+	}
+
+	const LetterMask revealed = guessed & ~renderedLetters;
+	if (revealed == 0)
+	{
+		return;
+	}
+	for (std::size_t i = 0; i < word.size(); ++i)
+	{
+		if ((letterBit(word[i]) & revealed) != 0)
+		{
+			wordLine[2 * i] = word[i];
+		}
+	}
+	renderedLetters = guessed;
+}
+
+/**
+ * Appends the letters of a mask in alphabetical order, each followed by a space.
+ *
+ * @param letters The set of letters.
+ * @param out Receives the letters.
+ */
+void FrameRenderer::appendLetters(const LetterMask letters, std::string& out)
+{
+	for (char letter = 'a'; letter <= 'z'; ++letter)
+	{
+		if ((letters & letterBit(letter)) != 0)
+		{
+			out += letter;
+			out += ' ';
+		}
+	}
+}
@@ -0,0 +1,270 @@
+#include <GameEngine.h>
+#include <JournalFormat.h>
+#include <Metrics.h>
+
+#include <utility>
+
+/**
+ * Constructs an engine that picks words from the given dictionary.
+ *
+ * @param dictionary The dictionary to pick words from.
+ */
+GameEngine::GameEngine(std::shared_ptr<const WordIndex> dictionary) :
+	dictionary(std::move(dictionary))
+{
+}
+
+/**
+ * Replaces the dictionary that later games pick words from.
+ *
+ * @param dictionary The dictionary to pick words from.
+ */
+void GameEngine::setDictionary(std::shared_ptr<const WordIndex> dictionary)
+{
+	this->dictionary = std::move(dictionary);
+}
+
+/**
+ * Seeds the random engine used to pick words.
+ *
+ * @param seed The seed for the word selection.
+ */
+void GameEngine::setSeed(const std::uint64_t seed)
+{
+	this->seed = seed;
+	random.setSeed(seed);
+}
+
+/**
+ * Records every game of this engine in a journal from the next game on. A
+ * game being recorded in the previous journal is recorded there as abandoned.
+ *
+ * @param journal The journal, or nullptr to stop recording.
+ */
+void GameEngine::setJournal(std::shared_ptr<Journal> journal)
+{
+	if (record.active())
+	{
+		record.finish(*this->journal, GameStatus::IN_PROGRESS);
+	}
+	this->journal = std::move(journal);
+}
+
+/**
+ * Seeds the engine and starts a new game with a word of the given difficulty.
+ *
+ * @param seed The seed for the word selection.
+ * @param difficulty The difficulty of the word.
+ * @return True if a game was started, false if the dictionary has no word of that difficulty.
+ */
+bool GameEngine::newGame(const std::uint64_t seed, const WordDifficultyTypes difficulty)
+{
+	setSeed(seed);
+	return newGame(difficulty);
+}
+
+/**
+ * Starts a new game with a word of the given difficulty.
+ *
+ * @param difficulty The difficulty of the word.
+ * @return True if a game was started, false if the dictionary has no word of that difficulty.
+ */
+bool GameEngine::newGame(const WordDifficultyTypes difficulty)
+{
+	if (!dictionary)
+	{
+		return false;
+	}
+	return newGame(dictionary->forDifficulty(difficulty), difficulty);
+}
+
+/**
+ * Starts a new game with a word picked from a list, by weight if the list has
+ * an alias table and uniformly otherwise, using the letter mask the index
+ * computed for it.
+ *
+ * @param words The words to pick from.
+ * @param difficulty The difficulty the list was taken for, recorded in the journal.
+ * @return True if a game was started, false if the list is empty.
+ */
+bool GameEngine::newGame(const WordListView& words, const std::optional<WordDifficultyTypes> difficulty)
+{
+	if (words.empty())
+	{
+		return false;
+	}
+
+	const ScopedTimer timer(MetricHistogram::WORD_PICK, Metrics::sampleNext());
+	const std::size_t index = words.pick(random);
+	reset(words[index], words.letterMask(index));
+	if (journal)
+	{
+		startRecord(words.index()->fingerprint(), difficulty, words.wordNumber(index));
+	}
+	return true;
+}
+
+/**
+ * Starts a new game with the given word.
+ *
+ * @param word The word to guess.
+ */
+void GameEngine::newGameWithWord(const std::string_view word)
+{
+	reset(word, letterMaskOf(word));
+	if (journal)
+	{
+		startRecord(0, std::nullopt, std::nullopt);
+	}
+}
+
+/**
+ * Resets the guess state for a new target word.
+ *
+ * @param word The word to guess.
+ * @param letters The distinct letters of the word.
+ */
+void GameEngine::reset(const std::string_view word, const LetterMask letters)
+{
+	if (record.active())
+	{
+		record.finish(*journal, GameStatus::IN_PROGRESS);
+	}
+
+	target.assign(word);
+	// Characters other than letters cannot be guessed and are always shown
+	masked = target;
+	for (auto& c : masked)
+	{
+		if (letterBit(c) != 0)
+		{
+			c = '_';
+		}
+	}
+	targetLetters = letters;
+	guessed = 0;
+	incorrect = 0;
+	attempts = MAX_NUMBER_TRIES;
+	// A word without letters is guessed from the start
+	state = letters == 0 ? GameStatus::WON : GameStatus::IN_PROGRESS;
+	Metrics::increment(MetricCounter::GAMES_STARTED);
+	if (state == GameStatus::WON)
+	{
+		Metrics::increment(MetricCounter::GAMES_WON);
+	}
+}
+
+/**
+ * Starts recording the game just reset. A word without letters is won before
+ * any guess, so its record is finished straight away.
+ *
+ * @param fingerprint The fingerprint of the word's dictionary, 0 for none.
+ * @param difficulty The difficulty of the word, if it was picked by difficulty.
+ * @param wordNumber The number of the word in its dictionary, if it was picked from one.
+ */
+void GameEngine::startRecord(const std::uint32_t fingerprint, const std::optional<WordDifficultyTypes> difficulty,
+                             const std::optional<std::uint32_t> wordNumber)
+{
+	record.start(seed, fingerprint, difficulty ? static_cast<std::uint8_t>(*difficulty) : 0, wordNumber, target);
+	if (state == GameStatus::WON)
+	{
+		record.finish(*journal, state);
+	}
+}
+
+/**
+ * Applies a guessed letter to the current game. Checking the guess and the
+ * win condition are each a single mask operation.
+ *
+ * @param letter The guessed letter.
+ * @return The outcome of the guess.
+ */
+GuessResult GameEngine::guess(const char letter)
+{
+	const ScopedTimer timer(MetricHistogram::GUESS, Metrics::sampleNext());
+	if (state != GameStatus::IN_PROGRESS)
+	{
+		return GuessResult::GAME_OVER;
+	}
+	Metrics::increment(MetricCounter::GUESSES);
+
+	const LetterMask bit = letterBit(letter);
+	if (bit == 0)
+	{
+		return GuessResult::NOT_A_LETTER;
+	}
+	if (record.active())
+	{
+		record.guess(letter);
+	}
+	if ((incorrect & bit) != 0)
+	{
+		return GuessResult::ALREADY_GUESSED_INCORRECTLY;
+	}
+	if ((guessed & bit) != 0)
+	{
+		return GuessResult::ALREADY_GUESSED;
+	}
+
+	guessed |= bit;
+	if ((targetLetters & bit) != 0)
+	{
+		for (std::size_t i = 0; i < target.size(); ++i)
+		{
+			if (letterBit(target[i]) == bit)
+			{
+				masked[i] = target[i];
+			}
+		}
+		if ((targetLetters & ~guessed) == 0)
+		{
+			state = GameStatus::WON;
+			Metrics::increment(MetricCounter::GAMES_WON);
+			if (record.active())
+			{
+				record.finish(*journal, state);
+			}
+		}
+		return GuessResult::CORRECT;
+	}
+
+	incorrect |= bit;
+	loseAttempt();
+	return GuessResult::INCORRECT;
+}
+
+/**
+ * Ends the current turn without a guess. It costs an attempt like an
+ * incorrect letter and is journaled as JournalFormat::TIMED_OUT.
+ *
+ * @return TIMED_OUT, or GAME_OVER if no game is in progress.
+ */
+GuessResult GameEngine::timeOut()
+{
+	if (state != GameStatus::IN_PROGRESS)
+	{
+		return GuessResult::GAME_OVER;
+	}
+	if (record.active())
+	{
+		record.guess(JournalFormat::TIMED_OUT);
+	}
+	loseAttempt();
+	return GuessResult::TIMED_OUT;
+}
+
+/**
+ * Takes an attempt away and ends the game as lost when none is left.
+ */
+void GameEngine::loseAttempt()
+{
+	if (--attempts == 0)
+	{
+		state = GameStatus::LOST;
+		Metrics::increment(MetricCounter::GAMES_LOST);
+		if (record.active())
+		{
+			record.finish(*journal, state);
+		}
+	}
+}
@@ -1,8 +1,35 @@
 #include <GameManager.h>
+#include <cctype>
+#include <charconv>
+#include <exception>
 #include <iostream>
 #include <memory>
-#include <random>
+#include <Metrics.h>
 #include <Player.h>
+#include <Solver.h>
+#include <Trace.h>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @param c A character of input.
+	 * @return True if the character separates words of input, like std::isspace().
+	 */
+	bool isSeparator(const char c)
+	{
+		return std::isspace(static_cast<unsigned char>(c)) != 0;
+	}
+}
+
+/**
+ * Constructs a game writing to a stream.
+ *
+ * @param output Receives everything shown to the player.
+ */
+GameManager::GameManager(std::ostream& output) : out(output)
+{
+}
 
 /**
  * Destructor for GameManager class.
@@ -15,260 +42,382 @@ GameManager::~GameManager()
 }
 
 /**
- * Generates a random number within a specified range.
+ * Selects a new target word randomly from the list of available words and
+ * starts a game with it.
  *
- * @param min The lower bound of the random number range (inclusive).
- * @param max The upper bound of the random number range (inclusive).
- * @return A randomly generated integer between min and max.
- */
-int GameManager::generateRandomNumber(const int min, const int max)
-{
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<> dis(min, max);
-	return dis(gen);
-}
-
-/**
- * Selects a new target word randomly from the list of available words.
+ * The list is refreshed from the dictionary's current snapshot first, so a
+ * reloaded dictionary is used from the next game on while the game in
+ * progress keeps its word.
  *
- * This method ensures that the list of words (wordList) is not empty before
- * attempting to select a new word. If the list is empty, an error message is
- * printed and the method exits early to prevent invalid operations.
+ * If the list of words (wordList) is empty, an error message is printed and
+ * the method exits early to prevent invalid operations.
  */
 void GameManager::getNewWord()
 {
-	// Ensure that wordList is not empty before selecting a random word
-	if (wordList.empty())
+	HANGMAN_TRACE_SCOPE("getNewWord");
+	wordList = file_manager.getIndex()->forDifficulty(currentDifficulty);
+
+	// The engine picks the word with the session's random engine, along with its precomputed letter mask
+	if (!engine.newGame(wordList, currentDifficulty))
 	{
-		std::cerr << "Error: wordList is empty!" << std::endl;
-		return; // Early exit if the list is empty
+		out << "Error: wordList is empty!" << std::endl;
 	}
-
-	// Select a random word from the wordList
-	targetWord = wordList[generateRandomNumber(0, static_cast<int>(wordList.size()) - 1)];
 }
 
 /**
  * Renders the current state of the game to the console.
  * This method displays the hangman, the current word being guessed,
- * incorrect guessed letters, and all guessed letters.
+ * incorrect guessed letters, and all guessed letters, composed into one
+ * frame that is written and flushed once.
  */
 void GameManager::draw() const
 {
-	displayHangman();
-
-	displayWord();
-
-	std::cout << "Incorrect Guessed Letters: ";
-	for (const auto letter : incorrectGuessedLetters)
-	{
-		std::cout << letter << " ";
-	}
-	std::cout << std::endl;
+	HANGMAN_TRACE_SCOPE("draw");
+	const ScopedTimer timer(MetricHistogram::RENDER);
+	const std::string_view frame = renderer.render(engine);
+	out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+	out.flush();
+}
 
-	std::cout << "Guessed Letters: ";
-	for (const auto letter : guessedLetters)
+/**
+ * Welcomes the player and asks for the name, or straight away for the
+ * difficulty when the name was set through setPlayerName().
+ */
+void GameManager::begin()
+{
+	out << "Welcome to Hangman - the classic word guessing game" << std::endl;
+	if (playerName.empty())
 	{
-		std::cout << letter << " ";
+		out << "Apologize for being personal but what is your name? ";
+		out.flush();
+		turn = TurnState::NAME;
+		return;
 	}
-	std::cout << std::endl;
+	promptDifficulty();
 }
 
 /**
- * Displays the current state of the target word.
+ * Plays the turns the input is enough for. Whitespace between words is
+ * skipped like `std::cin >>` does, and a word is only taken once the
+ * whitespace after it has arrived or the input has ended.
  *
- * This function prints out the target word with guessed letters shown and
- * un-guessed letters represented by underscores. After displaying the word,
- * the function prints a newline.
+ * @param input The input that has arrived and was not consumed before.
+ * @param endOfInput True if no more input will follow.
+ * @return The number of bytes consumed.
  */
-void GameManager::displayWord() const
+std::size_t GameManager::consume(const std::string_view input, const bool endOfInput)
 {
-	for (const auto& letter : targetWord)
+	std::size_t position = 0;
+	while (turn != TurnState::FINISHED)
 	{
-		if (guessedLetters.find(letter) != guessedLetters.end())
+		while (position < input.size() && isSeparator(input[position]))
 		{
-			std::cout << letter << " "; // Display guessed letter
+			++position;
 		}
-		else
+		if (position == input.size())
 		{
-			std::cout << "_"; // Display underscore for un-guessed letter
+			break;
+		}
+
+		std::size_t end = position + 1;
+		if (turn == TurnState::NAME || turn == TurnState::DIFFICULTY)
+		{
+			while (end < input.size() && !isSeparator(input[end]))
+			{
+				++end;
+			}
+			if (end == input.size() && !endOfInput)
+			{
+				break;
+			}
 		}
+		handleInput(input.substr(position, end - position));
+		position = end;
 	}
-	std::cout << std::endl; // End the line after displaying the word
-}
 
+	// Without more input the session is over, there is nobody left to answer
+	if (endOfInput)
+	{
+		turn = TurnState::FINISHED;
+		return input.size();
+	}
+	return position;
+}
 
 /**
- * Displays the current state of the hangman drawing based on the number of incorrect guesses.
- *
- * This method prints the hangman figure to the console, updating its appearance with each incorrect
- * guess. It visually represents the hangman with parts such as the head, body, arms, and legs being added
- * as the number of incorrect guesses increases. Additionally, it shows the number of attempts left.
+ * Handles one word or character of input in the current turn state.
  *
- * @note The hangman drawing is determined by the size of the `incorrectGuessedLetters` vector.
+ * @param input A whole word for NAME and DIFFICULTY, a single character otherwise.
  */
-void GameManager::displayHangman() const
+void GameManager::handleInput(const std::string_view input)
 {
-	switch(static_cast<int>(incorrectGuessedLetters.size())) {
-	case 0:
-		std::cout << "  ----\n  |  |\n     |\n     |\n     |\n     |\n=========";
-		break;
-	case 1:
-		std::cout << "  ----\n  |  |\n  O  |\n     |\n     |\n     |\n=========";
-		break;
-	case 2:
-		std::cout << "  ----\n  |  |\n  O  |\n  |  |\n     |\n     |\n=========";
-		break;
-	case 3:
-		std::cout << "  ----\n  |  |\n  O  |\n /|  |\n     |\n     |\n=========";
+	switch (turn)
+	{
+	case TurnState::NAME:
+		playerName = input;
+		out << std::endl;
+		promptDifficulty();
 		break;
-	case 4:
-		std::cout << "  ----\n  |  |\n  O  |\n /|\\ |\n     |\n     |\n=========";
+	case TurnState::DIFFICULTY:
+		chooseDifficulty(input);
 		break;
-	case 5:
-		std::cout << "  ----\n  |  |\n  O  |\n /|\\ |\n /   |\n     |\n=========";
+	case TurnState::GUESS:
+		takeGuess(input.front());
 		break;
-	case 6:
-		std::cout << "  ----\n  |  |\n  O  |\n /|\\ |\n / \\ |\n     |\n=========";
+	case TurnState::PLAY_AGAIN:
+		answerPlayAgain(input.front());
 		break;
-	default:
-		std::cout << "Invalid number of incorrect guesses.";
+	case TurnState::FINISHED:
 		break;
 	}
-	std::cout << std::endl << "Attempts Left: " << attemptsLeft << std::endl;
 }
 
 /**
- * Starts a new game of Hangman.
- *
- * This method welcomes the player, prompts them to enter their name,
- * creates a new Player instance with the provided name, and begins a new game.
- *
- * It outputs a welcome message and a personalized game creation message.
- *
- * @note This method handles user input and standard output operations.
+ * Ends the turn the player took too long for: a guess costs an attempt, any
+ * other prompt finishes the game.
  */
-void GameManager::start()
+void GameManager::timeOut()
 {
+	if (turn != TurnState::GUESS)
+	{
+		if (turn != TurnState::FINISHED)
+		{
+			out << std::endl << "Time is up, goodbye!" << std::endl;
+			turn = TurnState::FINISHED;
+		}
+		return;
+	}
 
+	out << std::endl;
+	const GuessResult result = engine.timeOut();
+	handle_guess_result('\0', result);
+	if (engine.over() && result != GuessResult::GAME_OVER)
+	{
+		recordGame();
+	}
+	nextTurn();
+}
+
+/**
+ * Asks the player for the difficulty of the next game.
+ */
+void GameManager::promptDifficulty()
+{
+	out << "Select Difficulty: " << std::endl;
+	out << "1. Easy" << std::endl;
+	out << "2. Medium" << std::endl;
+	out << "3. Hard" << std::endl;
+	turn = TurnState::DIFFICULTY;
+}
 
-	std::cout << "Select Difficulty: " << std::endl;
-	std::cout << "1. Easy" << std::endl;
-	std::cout << "2. Medium" << std::endl;
-	std::cout << "3. Hard" << std::endl;
+/**
+ * Starts a new game of Hangman at the chosen difficulty.
+ *
+ * Creates the Player instance with the name entered or set through
+ * setPlayerName() on first use, loading the stored profile of a returning
+ * player, and outputs a personalized game creation message.
+ *
+ * @param answer The player's answer, 1 to 3.
+ */
+void GameManager::chooseDifficulty(const std::string_view answer)
+{
+	HANGMAN_TRACE_SCOPE("start");
 
-	int difficulty;
-	std::cin >> difficulty;
+	int difficulty{0};
+	const auto [end, error] = std::from_chars(answer.data(), answer.data() + answer.size(), difficulty);
+	if (error != std::errc() || end != answer.data() + answer.size() ||
+	    difficulty < static_cast<int>(WordDifficultyTypes::EASY) || difficulty > static_cast<int>(WordDifficultyTypes::HARD))
+	{
+		out << "Please choose 1, 2 or 3." << std::endl;
+		return;
+	}
 
-	wordList = file_manager.getWordList(static_cast<WordDifficultyTypes>(difficulty));
-	getNewWord();
+	setDifficulty(static_cast<WordDifficultyTypes>(difficulty));
+	newGame();
 
-	player = new Player(playerName);
-	std::cout << "Creating a new game for you " << player->getName() << std::endl;
+	if (player == nullptr)
+	{
+		player = new Player(playerName);
+		if (const auto stored = players ? players->find(playerName) : std::nullopt)
+		{
+			profile = *stored;
+			out << "Welcome back! Level " << profile.level << ", score " << profile.score << ", " << profile.wins
+			    << " won, " << profile.losses << " lost" << std::endl;
+		}
+		player->setLevel(static_cast<int>(profile.level));
+	}
+	out << "Creating a new game for you " << player->getName() << std::endl;
+	nextTurn();
 }
 
 /**
- * Prompts the player to guess a letter and processes the input.
+ * Sets the difficulty used for the words of the following games.
  *
- * This function outputs a message asking the player to guess a letter, reads the input,
- * converts the letter to lowercase, and then checks if the guessed letter is correct.
+ * @param difficulty The difficulty level.
  */
-void GameManager::menu()
+void GameManager::setDifficulty(const WordDifficultyTypes difficulty)
 {
-	char letter;
-	std::cout << std::endl;
-	std::cout << player->getName();
-	std::cout << " Please guess a letter: ";
-	std::cin >> letter;
+	currentDifficulty = difficulty;
+}
 
-	letter = static_cast<char>(tolower(letter));
+/**
+ * Draws the game and asks for the next letter. Once the game is over the
+ * outcome is announced instead and the player is asked to play again.
+ */
+void GameManager::nextTurn()
+{
+	draw();
+	if (engine.won())
+	{
+		out << "You win! You guessed the word - " << engine.targetWord() << std::endl;
+	}
+	else if (engine.lost())
+	{
+		out << "You lose! The word was - " << engine.targetWord() << std::endl;
+	}
 
-	guessLetter(letter);
+	// A game that could not be started is over as well
+	if (engine.status() != GameStatus::IN_PROGRESS)
+	{
+		out << "Play again? [y,n]): ";
+		out.flush();
+		turn = TurnState::PLAY_AGAIN;
+		return;
+	}
+
+	out << std::endl;
+	out << player->getName();
+	out << " Please guess a letter (? for a hint): ";
+	out.flush();
+	turn = TurnState::GUESS;
 }
 
 /**
- * Handles the result of a guessed letter in the game.
- * Determines whether the guessed letter is in the word, updates guessed and incorrect letter collections,
- * and manages remaining attempts.
+ * Processes a character entered at the guess prompt: '?' asks for a hint,
+ * anything else is converted to lowercase and guessed.
  *
- * @param letter The letter that was guessed.
- * @param maxTriesExceeded A reference to a bool that will be set to true if the maximum number of allowed tries is exceeded.
- * @param letterFound Indicates whether the guessed letter was found in the word.
- * @param letter_ The letter to be inserted into the incorrect guessed letters collection if the guess is wrong.
+ * @param letter The character entered by the player.
  */
-bool GameManager::handle_guess_result(const char letter, bool& maxTriesExceeded, const bool letterFound,
-                                      const char letter_)
+void GameManager::takeGuess(const char letter)
 {
-	bool keepGuessing = true;
-
-	// Handle the result of the guess
-	if (letterFound)
+	HANGMAN_TRACE_SCOPE("menu");
+	if (letter == '?')
 	{
-		std::cout << "Good guess! The letter '" << letter << "' is in the word!" << std::endl;
+		showHint();
 	}
 	else
 	{
-		std::cout << "Incorrect guess!" << std::endl;
-		incorrectGuessedLetters.insert(letter_); // Add to incorrectGuessedLetters
+		guessLetter(static_cast<char>(tolower(letter)));
+	}
+	nextTurn();
+}
 
+/**
+ * Suggests the letter that best splits the dictionary words still consistent
+ * with the guesses so far.
+ */
+void GameManager::showHint() const
+{
+	Solver solver(file_manager.getIndex()->wordsOfLength(engine.targetWord().size()));
+	solver.update(engine.maskedWord(), engine.incorrectLetters());
 
-		if (attemptsLeft > 0 && attemptsLeft <= MAX_NUMBER_TRIES)
-		{
-			decrementAttemptsLeft();
-		}
-		else
-		{
-			maxTriesExceeded = true;
-			keepGuessing = false;
-		}
+	if (const char letter = solver.bestGuess(); letter != '\0')
+	{
+		out << "Hint: " << solver.candidateCount() << " words still fit, try the letter '" << letter << "'."
+		    << std::endl;
+	}
+	else
+	{
+		out << "Sorry, no hint available for this word." << std::endl;
 	}
-	guessedLetters.insert(letter);
-	return keepGuessing;
+}
+
+/**
+ * Handles the result of a guessed letter in the game.
+ * Tells the player whether the guessed letter is in the word, or why the guess did not count.
+ *
+ * @param letter The letter that was guessed.
+ * @param result The outcome reported by the engine.
+ * @return Whether the player should keep guessing.
+ */
+bool GameManager::handle_guess_result(const char letter, const GuessResult result)
+{
+	// Handle the result of the guess
+	switch (result)
+	{
+	case GuessResult::CORRECT:
+		out << "Good guess! The letter '" << letter << "' is in the word!" << std::endl;
+		break;
+	case GuessResult::INCORRECT:
+		out << "Incorrect guess!" << std::endl;
+		break;
+	case GuessResult::ALREADY_GUESSED_INCORRECTLY:
+		out << "The letter '" << letter << "' has already been guessed incorrectly." << std::endl;
+		break;
+	case GuessResult::ALREADY_GUESSED:
+		out << "You already guessed the letter '" << letter << "'." << std::endl;
+		break;
+	case GuessResult::NOT_A_LETTER:
+		out << "'" << letter << "' is not a letter, please guess a letter from a to z." << std::endl;
+		break;
+	case GuessResult::TIMED_OUT:
+		out << "Time is up! That cost you an attempt." << std::endl;
+		break;
+	case GuessResult::GAME_OVER:
+		break;
+	}
+	return !engine.over();
 }
 
 /**
  * Handles the guessing of a letter in the game.
  *
  * @param letter The letter being guessed by the player.
- * @return true if the maximum number of tries have been exceeded after the guess, otherwise false.
  */
 void GameManager::guessLetter(const char letter)
 {
-	bool maxTriesExceeded = false;
-	// Flag to check if the letter is in the target word
-	bool letterFound = false;
-
+	HANGMAN_TRACE_SCOPE("guessLetter");
 	// make the letter case-insensitive
+	const char letter_ = static_cast<char>(tolower(letter));
+
+	const GuessResult result = engine.guess(letter_);
+	handle_guess_result(letter_, result);
 
-	// Check if the letter has already been guessed correctly or incorrectly
-	if (const char letter_ = static_cast<char>(tolower(letter));
-		guessedLetters.find(letter_) != guessedLetters.end())
+	// Only the guess that ends the game is counted, later ones report GAME_OVER
+	if (engine.over() && result != GuessResult::GAME_OVER)
 	{
-		std::cout << "You already guessed the letter '" << letter << "'." << std::endl;
+		recordGame();
 	}
-	else
+}
+
+/**
+ * Adds the outcome of the finished game to the profile, through the store
+ * when there is one so concurrent sessions of the same player add up.
+ * A profile that cannot be stored is kept for the session.
+ */
+void GameManager::recordGame()
+{
+	const bool won = engine.won();
+	if (players)
 	{
-		// If the letter is incorrect and not already guessed incorrectly
-		if (incorrectGuessedLetters.find(letter_) != incorrectGuessedLetters.end())
+		try
 		{
-			std::cout << "The letter '" << letter_ << "' has already been guessed incorrectly." << std::endl;
+			profile = players->recordGame(playerName, won, engine.attemptsLeft(), currentDifficulty);
 		}
-		else
+		catch (const std::exception& e)
 		{
-			// Iterate over the target word to check if the letter is present
-			for (const auto& letter_s : targetWord)
-			{
-				if (letter_s == letter_)
-				{
-					letterFound = true;
-					break;
-				}
-			}
-
-			handle_guess_result(letter, maxTriesExceeded, letterFound, letter_);
+			out << "Your profile could not be saved: " << e.what() << std::endl;
+			profile.recordGame(won, engine.attemptsLeft(), currentDifficulty);
 		}
 	}
+	else
+	{
+		profile.recordGame(won, engine.attemptsLeft(), currentDifficulty);
+	}
+	if (player != nullptr)
+	{
+		player->setLevel(static_cast<int>(profile.level));
+	}
 }
 
 
@@ -280,25 +429,7 @@ void GameManager::guessLetter(const char letter)
  */
 bool GameManager::didWin() const
 {
-	// If there are no attempts left, player loses
-	if (this->attemptsLeft == 0)
-	{
-		this->game_state = true;
-		return false;
-	}
-
-	// Check if every letter in targetWord has been guessed
-	for (const auto& c : targetWord)
-	{
-		if (guessedLetters.find(c) == guessedLetters.end())
-		{
-			return false;
-		}
-	}
-
-	// If all letters have been guessed, player wins
-	this->game_state = true;
-	return true;
+	return engine.won();
 }
 
 /**
@@ -308,97 +439,94 @@ bool GameManager::didWin() const
  */
 int GameManager::getAttemptsLeft() const
 {
-	return attemptsLeft;
+	return engine.attemptsLeft();
 }
 
 /**
- * Starts a new game by resetting the guessed letters, incorrect guessed letters,
- * setting the number of attempts left to the maximum allowed, and retrieving a new word.
+ * Starts a new game by retrieving a new word, which resets the guessed letters,
+ * incorrect guessed letters and the number of attempts left.
  */
 void GameManager::newGame()
 {
-	guessedLetters.clear();
-	incorrectGuessedLetters.clear();
-	attemptsLeft = MAX_NUMBER_TRIES;
+	HANGMAN_TRACE_SCOPE("newGame");
 	getNewWord();
-	game_state = false;
 }
 
 /**
- * Decrements the number of attempts left by one.
+ * Retrieves the set of guessed letters.
  *
- * @return The updated number of attempts left after decrement.
+ * @return A bitmask of the letters that have been guessed.
  */
-void GameManager::decrementAttemptsLeft()
+LetterMask GameManager::getGuessedLetters() const
 {
-	attemptsLeft--;
+	return engine.guessedLetters();
 }
 
 /**
- * Retrieves the set of guessed letters.
+ * Handles the answer to "Play again?": anything but 'n' (case-insensitive)
+ * asks for the difficulty of a new game, 'n' says goodbye and finishes.
  *
- * @return A set containing characters that have been guessed.
+ * @param answer The character entered by the player.
  */
-std::set<char> GameManager::getGuessedLetters()
+void GameManager::answerPlayAgain(const char answer)
 {
-	return guessedLetters;
+	HANGMAN_TRACE_SCOPE("playAgain");
+	if (tolower(answer) != 'n')
+	{
+		promptDifficulty();
+		return;
+	}
+
+	out << "Thanks for playing! Exiting the game..." << std::endl;
+	turn = TurnState::FINISHED;
 }
 
 /**
- * Prompts the user to decide whether to play again or exit the game.
- * Reads user input and starts a new game if the response is not 'n'
- * (case-insensitive); otherwise, terminates the program.
+ * Checks if the game is over.
+ * @return True if the game has been won or lost, otherwise false.
  */
-void GameManager::playAgain()
+bool GameManager::gameOver() const
 {
-	// Logic to read user input (e.g., using std::cin or event handling)
-	// Example for console-based input:
-	char input;
-	std::cout << "Play again? [y,n]): ";
-	std::cin >> input;
-
-	input = static_cast<char>(tolower(input));
-	if (input != 'n')
-	{
-		newGame();
-		start();
-	}
-	else
-	{
-		std::cout << "Thanks for playing! Exiting the game..." << std::endl;
-		std::exit(EXIT_SUCCESS);
-	}
+	return engine.over();
 }
 
-/**
- * @brief Retrieves the number of letters in the current target word.
- *
- * This method returns the count of characters in the `targetWord`.
- *
- * @return The number of letters in the `targetWord`.
- */
-int GameManager::getNumberOfLettersInWord() const
+void GameManager::setPlayerName(const std::string& name_)
 {
-	return static_cast<int>(targetWord.length());
+	playerName = name_;
 }
 
+std::string GameManager::getTargetWord()
+{
+	return engine.targetWord();
+}
 
 /**
- * Checks if the game is over.
- * @return True if the game is over, otherwise false.
+ * Seeds the random engine used to pick words.
+ *
+ * @param seed The seed for the word selection.
  */
-bool GameManager::gameOver() const
+void GameManager::setSeed(const std::uint64_t seed)
 {
-	return game_state;
+	engine.setSeed(seed);
 }
 
-void GameManager::setPlayerName(const std::string& name_)
+/**
+ * Keeps the player's profile in a store across sessions.
+ *
+ * @param store The store, or nullptr to keep nothing.
+ */
+void GameManager::setPlayerStore(std::shared_ptr<PlayerStore> store)
 {
-	playerName = name_;
+	players = std::move(store);
 }
 
-std::string GameManager::getTargetWord()
+/**
+ * Records every game from the next one on in a journal.
+ *
+ * @param journal The journal, or nullptr to stop recording.
+ */
+void GameManager::setJournal(std::shared_ptr<Journal> journal)
 {
-	return targetWord;
+	engine.setJournal(std::move(journal));
 }
 
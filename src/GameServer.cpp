@@ -0,0 +1,689 @@
+#include <GameServer.h>
+#include <GameSession.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	/**
+	 * Throws the error in errno.
+	 *
+	 * @param what The failed operation.
+	 */
+	[[noreturn]] void throwSystemError(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+
+	/**
+	 * @brief Epoll events reported per wait.
+	 */
+	constexpr int MAX_EVENTS = 256;
+}
+
+/**
+ * @class GameServer::Reactor
+ * @brief One event loop thread and the connections it accepted.
+ */
+class GameServer::Reactor
+{
+public:
+	/**
+	 * @brief Creates the epoll instance and registers the listener.
+	 *
+	 * @param server The server, for its configuration and session counter.
+	 * @param listener The listening socket, owned by the server.
+	 * @param shared Whether other reactors poll the same listener.
+	 */
+	Reactor(GameServer& server, int listener, bool shared);
+
+	/**
+	 * @brief Closes the connections and the epoll instance.
+	 */
+	~Reactor();
+
+	/**
+	 * @brief Deleted copy constructor, the reactor owns its epoll instance.
+	 */
+	Reactor(const Reactor& other) = delete;
+
+	/**
+	 * @brief Deleted copy assignment, the reactor owns its epoll instance.
+	 */
+	Reactor& operator=(const Reactor& other) = delete;
+
+	/**
+	 * @brief Serves connections until wake() is called.
+	 */
+	void run();
+
+	/**
+	 * @brief Makes run() return, callable from any thread.
+	 */
+	void wake() const;
+
+private:
+	/**
+	 * @brief A client connection and its session.
+	 */
+	struct Connection
+	{
+		Connection(const int fd, std::shared_ptr<const DictionaryStore> dictionary, const std::uint64_t seed,
+		           std::shared_ptr<PlayerStore> players, std::shared_ptr<Leaderboard> leaderboard,
+		           std::shared_ptr<Journal> journal)
+			: fd(fd), session(std::move(dictionary), seed, std::move(players), std::move(leaderboard), std::move(journal))
+		{
+		}
+
+		/**
+		 * @brief The connected socket.
+		 */
+		int fd;
+
+		/**
+		 * @brief The player's games.
+		 */
+		GameSession session;
+
+		/**
+		 * @brief Received bytes of an incomplete request line.
+		 */
+		std::string input;
+
+		/**
+		 * @brief Replies not yet written, starting at offset `written`.
+		 */
+		std::string output;
+
+		/**
+		 * @brief Bytes of `output` already sent.
+		 */
+		std::size_t written{0};
+
+		/**
+		 * @brief The epoll events the connection is registered for.
+		 */
+		std::uint32_t events{0};
+
+		/**
+		 * @brief Close the connection once the output is written.
+		 */
+		bool closing{false};
+	};
+
+	/**
+	 * @brief Accepts every pending connection.
+	 */
+	void acceptConnections();
+
+	/**
+	 * @brief Reads from a connection and answers every complete request.
+	 *
+	 * @param connection The connection.
+	 * @return False if the connection was closed.
+	 */
+	bool readRequests(Connection& connection);
+
+	/**
+	 * @brief Answers the complete lines of a chunk of input.
+	 *
+	 * @param connection The connection.
+	 * @param data The input.
+	 * @return The number of bytes consumed, up to the end of the last complete line.
+	 */
+	static std::size_t handleLines(Connection& connection, std::string_view data);
+
+	/**
+	 * @brief Writes as much pending output as the socket accepts.
+	 *
+	 * @param connection The connection.
+	 * @return False if the connection failed.
+	 */
+	static bool writeReplies(Connection& connection);
+
+	/**
+	 * @brief Brings the epoll registration of a connection in line with its buffers, closing it when done.
+	 *
+	 * @param connection The connection.
+	 */
+	void updateInterest(Connection& connection);
+
+	/**
+	 * @brief Closes a connection and drops its session.
+	 *
+	 * @param fd The connection's socket.
+	 */
+	void closeConnection(int fd);
+
+	/**
+	 * @brief The server, for its configuration and session counter.
+	 */
+	GameServer& server;
+
+	/**
+	 * @brief The listening socket, owned by the server.
+	 */
+	int listener;
+
+	/**
+	 * @brief The epoll instance.
+	 */
+	int epoll{-1};
+
+	/**
+	 * @brief Signalled by wake().
+	 */
+	int wakeFd{-1};
+
+	/**
+	 * @brief The session table, keyed by socket.
+	 */
+	std::unordered_map<int, Connection> connections;
+
+	/**
+	 * @brief Receives the bytes of one read, shared by all connections of the reactor.
+	 */
+	std::vector<char> readBuffer;
+};
+
+/**
+ * Creates the epoll instance and the wake-up eventfd and registers the listener.
+ *
+ * @param server The server, for its configuration and session counter.
+ * @param listener The listening socket, owned by the server.
+ * @param shared Whether other reactors poll the same listener.
+ */
+GameServer::Reactor::Reactor(GameServer& server, const int listener, const bool shared)
+	: server(server), listener(listener), readBuffer(READ_BUFFER_SIZE)
+{
+	epoll = ::epoll_create1(EPOLL_CLOEXEC);
+	if (epoll < 0)
+	{
+		throwSystemError("epoll_create1");
+	}
+	wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (wakeFd < 0)
+	{
+		const int error = errno;
+		::close(epoll);
+		errno = error;
+		throwSystemError("eventfd");
+	}
+
+	epoll_event event{};
+	// Only one of the reactors sharing a listener is woken per connection
+	event.events = shared ? EPOLLIN | EPOLLEXCLUSIVE : EPOLLIN;
+	event.data.fd = listener;
+	epoll_event wakeEvent{};
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.fd = wakeFd;
+	if (::epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &event) < 0 || ::epoll_ctl(epoll, EPOLL_CTL_ADD, wakeFd, &wakeEvent) < 0)
+	{
+		const int error = errno;
+		::close(wakeFd);
+		::close(epoll);
+		errno = error;
+		throwSystemError("epoll_ctl");
+	}
+}
+
+/**
+ * Closes the remaining connections, the eventfd and the epoll instance.
+ */
+GameServer::Reactor::~Reactor()
+{
+	for (const auto& [fd, connection] : connections)
+	{
+		::close(fd);
+	}
+	::close(wakeFd);
+	::close(epoll);
+}
+
+/**
+ * Waits for events and dispatches them until woken. Connections are closed on exit.
+ */
+void GameServer::Reactor::run()
+{
+	epoll_event events[MAX_EVENTS];
+	for (;;)
+	{
+		const int count = ::epoll_wait(epoll, events, MAX_EVENTS, -1);
+		if (count < 0 && errno != EINTR)
+		{
+			break;
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			const int fd = events[i].data.fd;
+			if (fd == wakeFd)
+			{
+				std::uint64_t value;
+				[[maybe_unused]] const auto ignored = ::read(wakeFd, &value, sizeof(value));
+				for (const auto& [connectionFd, connection] : connections)
+				{
+					::close(connectionFd);
+				}
+				connections.clear();
+				return;
+			}
+			if (fd == listener)
+			{
+				acceptConnections();
+				continue;
+			}
+
+			const auto found = connections.find(fd);
+			if (found == connections.end())
+			{
+				continue;
+			}
+			Connection& connection = found->second;
+			if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+			{
+				closeConnection(fd);
+				continue;
+			}
+			if ((events[i].events & EPOLLIN) != 0 && !readRequests(connection))
+			{
+				continue;
+			}
+			if ((events[i].events & EPOLLOUT) != 0 && !writeReplies(connection))
+			{
+				closeConnection(fd);
+				continue;
+			}
+			updateInterest(connection);
+		}
+	}
+}
+
+/**
+ * Signals the reactor's eventfd.
+ */
+void GameServer::Reactor::wake() const
+{
+	const std::uint64_t one = 1;
+	[[maybe_unused]] const auto ignored = ::write(wakeFd, &one, sizeof(one));
+}
+
+/**
+ * Accepts connections until none is pending. Each gets a session seeded from the server's counter.
+ */
+void GameServer::Reactor::acceptConnections()
+{
+	for (;;)
+	{
+		const int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+		{
+			// EAGAIN once drained or taken by another reactor; other errors are retried on the next event
+			return;
+		}
+		if (server.config.unixSocket.empty())
+		{
+			const int noDelay = 1;
+			::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+		}
+
+		const std::uint64_t seed = server.config.seed + server.nextSession.fetch_add(1, std::memory_order_relaxed);
+		auto& connection = connections.try_emplace(fd, fd, server.config.dictionary, seed, server.config.players,
+		                                                   server.config.leaderboard, server.config.journal).first->second;
+		connection.events = EPOLLIN | EPOLLRDHUP;
+
+		epoll_event event{};
+		event.events = connection.events;
+		event.data.fd = fd;
+		if (::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+		{
+			closeConnection(fd);
+		}
+	}
+}
+
+/**
+ * Reads once and answers the complete requests. Requests that arrive together
+ * are answered together, with one write.
+ *
+ * @param connection The connection.
+ * @return False if the connection was closed.
+ */
+bool GameServer::Reactor::readRequests(Connection& connection)
+{
+	const ssize_t received = ::recv(connection.fd, readBuffer.data(), readBuffer.size(), 0);
+	if (received == 0 || (received < 0 && errno != EAGAIN && errno != EINTR))
+	{
+		closeConnection(connection.fd);
+		return false;
+	}
+	if (received < 0)
+	{
+		return true;
+	}
+
+	std::string_view data(readBuffer.data(), static_cast<std::size_t>(received));
+	if (connection.input.empty())
+	{
+		// The common case: whole requests straight from the read buffer, without copying them
+		const std::size_t consumed = handleLines(connection, data);
+		connection.input.assign(data.substr(consumed));
+	}
+	else
+	{
+		connection.input.append(data);
+		const std::size_t consumed = handleLines(connection, connection.input);
+		connection.input.erase(0, consumed);
+	}
+
+	if (connection.input.size() > GameSession::MAX_LINE_LENGTH && !connection.closing)
+	{
+		connection.output += "ERR line too long\n";
+		connection.closing = true;
+	}
+	if (connection.closing)
+	{
+		connection.input.clear();
+	}
+
+	if (!writeReplies(connection))
+	{
+		closeConnection(connection.fd);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Answers every complete line, stopping after a request that ends the session.
+ *
+ * @param connection The connection.
+ * @param data The input.
+ * @return The number of bytes consumed.
+ */
+std::size_t GameServer::Reactor::handleLines(Connection& connection, const std::string_view data)
+{
+	std::size_t start = 0;
+	while (!connection.closing)
+	{
+		const std::size_t end = data.find('\n', start);
+		if (end == std::string_view::npos)
+		{
+			break;
+		}
+		connection.session.handleLine(data.substr(start, end - start), connection.output);
+		connection.closing = connection.session.closed();
+		start = end + 1;
+	}
+	return start;
+}
+
+/**
+ * Writes pending output until it is all sent or the socket is full.
+ *
+ * @param connection The connection.
+ * @return False if the connection failed.
+ */
+bool GameServer::Reactor::writeReplies(Connection& connection)
+{
+	while (connection.written < connection.output.size())
+	{
+		const ssize_t sent = ::send(connection.fd, connection.output.data() + connection.written,
+		                            connection.output.size() - connection.written, MSG_NOSIGNAL);
+		if (sent < 0)
+		{
+			return errno == EAGAIN || errno == EINTR;
+		}
+		connection.written += static_cast<std::size_t>(sent);
+	}
+	connection.output.clear();
+	connection.written = 0;
+	return true;
+}
+
+/**
+ * Polls for writability while output is pending, stops reading while too much
+ * is pending, and closes a finished connection once its replies are sent.
+ *
+ * @param connection The connection.
+ */
+void GameServer::Reactor::updateInterest(Connection& connection)
+{
+	const std::size_t pending = connection.output.size() - connection.written;
+	if (connection.closing && pending == 0)
+	{
+		closeConnection(connection.fd);
+		return;
+	}
+
+	std::uint32_t events = EPOLLRDHUP;
+	if (!connection.closing && pending < MAX_PENDING_OUTPUT)
+	{
+		events |= EPOLLIN;
+	}
+	if (pending > 0)
+	{
+		events |= EPOLLOUT;
+	}
+	if (events == connection.events)
+	{
+		return;
+	}
+
+	epoll_event event{};
+	event.events = events;
+	event.data.fd = connection.fd;
+	if (::epoll_ctl(epoll, EPOLL_CTL_MOD, connection.fd, &event) < 0)
+	{
+		closeConnection(connection.fd);
+		return;
+	}
+	connection.events = events;
+}
+
+/**
+ * Ends the session of a connection and closes it; closing the socket also
+ * removes it from the epoll set. A profile that cannot be saved any more is
+ * not worth stopping the reactor for.
+ *
+ * @param fd The connection's socket.
+ */
+void GameServer::Reactor::closeConnection(const int fd)
+{
+	if (const auto found = connections.find(fd); found != connections.end())
+	{
+		try
+		{
+			found->second.session.end();
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+	::close(fd);
+	connections.erase(fd);
+}
+
+/**
+ * Opens the listening sockets and creates one reactor per thread.
+ *
+ * @param config Where to listen and what to serve.
+ */
+GameServer::GameServer(ServerConfig config) : config(std::move(config))
+{
+	if (!this->config.dictionary)
+	{
+		throw std::invalid_argument("GameServer needs a dictionary");
+	}
+
+	std::size_t reactorCount = this->config.threads;
+	if (reactorCount == 0)
+	{
+		reactorCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	const bool shared = !this->config.unixSocket.empty();
+
+	try
+	{
+		for (std::size_t i = 0; i < reactorCount; ++i)
+		{
+			if (!shared || listeners.empty())
+			{
+				listeners.push_back(openListener());
+			}
+			reactors.push_back(std::make_unique<Reactor>(*this, listeners.back(), shared));
+		}
+	}
+	catch (...)
+	{
+		reactors.clear();
+		for (const int listener : listeners)
+		{
+			::close(listener);
+		}
+		throw;
+	}
+}
+
+/**
+ * Stops the reactors, then closes the listeners and removes the Unix socket file.
+ */
+GameServer::~GameServer()
+{
+	stop();
+	reactors.clear();
+	for (const int listener : listeners)
+	{
+		::close(listener);
+	}
+	if (!config.unixSocket.empty())
+	{
+		std::error_code ignored;
+		std::filesystem::remove(config.unixSocket, ignored);
+	}
+}
+
+/**
+ * Starts one thread per reactor.
+ */
+void GameServer::start()
+{
+	if (!threads.empty())
+	{
+		return;
+	}
+	for (const auto& reactor : reactors)
+	{
+		threads.emplace_back([&reactor] { reactor->run(); });
+	}
+}
+
+/**
+ * Wakes every reactor and joins the threads.
+ */
+void GameServer::stop()
+{
+	for (const auto& reactor : reactors)
+	{
+		reactor->wake();
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	threads.clear();
+}
+
+/**
+ * Creates, binds and listens on a socket for the configured address. TCP
+ * sockets are bound with SO_REUSEPORT, so every reactor can have its own; the
+ * first one resolves port 0 for the others.
+ *
+ * @return The listening socket.
+ */
+int GameServer::openListener()
+{
+	const bool unixDomain = !config.unixSocket.empty();
+	const int fd = ::socket(unixDomain ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+	{
+		throwSystemError("socket");
+	}
+
+	try
+	{
+		if (unixDomain)
+		{
+			sockaddr_un address{};
+			address.sun_family = AF_UNIX;
+			const std::string path = config.unixSocket.string();
+			if (path.size() >= sizeof(address.sun_path))
+			{
+				throw std::invalid_argument("Unix socket path too long: " + path);
+			}
+			std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+			// A socket file left behind by a previous run would make bind fail
+			std::error_code ignored;
+			std::filesystem::remove(config.unixSocket, ignored);
+			if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+			{
+				throwSystemError("bind");
+			}
+		}
+		else
+		{
+			const int enable = 1;
+			if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0 ||
+			    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0)
+			{
+				throwSystemError("setsockopt");
+			}
+
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_port = htons(boundPort != 0 ? boundPort : config.port);
+			if (::inet_pton(AF_INET, config.host.c_str(), &address.sin_addr) != 1)
+			{
+				throw std::invalid_argument("Not an IPv4 address: " + config.host);
+			}
+			if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+			{
+				throwSystemError("bind");
+			}
+
+			socklen_t length = sizeof(address);
+			if (::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0)
+			{
+				throwSystemError("getsockname");
+			}
+			boundPort = ntohs(address.sin_port);
+		}
+
+		if (::listen(fd, SOMAXCONN) < 0)
+		{
+			throwSystemError("listen");
+		}
+	}
+	catch (...)
+	{
+		::close(fd);
+		throw;
+	}
+	return fd;
+}
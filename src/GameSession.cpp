@@ -0,0 +1,317 @@
+#include <GameSession.h>
+#include <Metrics.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief Names of the GuessResult values, in declaration order.
+	 */
+	constexpr std::string_view GUESS_RESULT_NAMES[] = {"CORRECT", "INCORRECT", "ALREADY_GUESSED",
+	                                                   "ALREADY_GUESSED_INCORRECTLY", "NOT_A_LETTER", "TIMED_OUT",
+	                                                   "GAME_OVER"};
+
+	/**
+	 * @brief Names of the GameStatus values, in declaration order.
+	 */
+	constexpr std::string_view GAME_STATUS_NAMES[] = {"NOT_STARTED", "IN_PROGRESS", "WON", "LOST"};
+
+	/**
+	 * Splits the first space-separated token off a string.
+	 *
+	 * @param text The text, advanced past the token and the spaces that follow it.
+	 * @return The token, empty if the text is blank.
+	 */
+	std::string_view nextToken(std::string_view& text)
+	{
+		const auto start = text.find_first_not_of(' ');
+		if (start == std::string_view::npos)
+		{
+			text = {};
+			return {};
+		}
+		text.remove_prefix(start);
+		const auto end = std::min(text.find(' '), text.size());
+		const std::string_view token = text.substr(0, end);
+		text.remove_prefix(end);
+		return token;
+	}
+
+	/**
+	 * Compares a token with a lowercase keyword, ignoring case.
+	 *
+	 * @param token The token from the request.
+	 * @param keyword The lowercase keyword.
+	 * @return True if they are equal apart from case.
+	 */
+	bool isKeyword(const std::string_view token, const std::string_view keyword)
+	{
+		if (token.size() != keyword.size())
+		{
+			return false;
+		}
+		for (std::size_t i = 0; i < token.size(); ++i)
+		{
+			if (std::tolower(static_cast<unsigned char>(token[i])) != keyword[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+/**
+ * Constructs a session picking words from a shared dictionary.
+ *
+ * @param dictionary The store of the dictionary, shared by every session.
+ * @param seed The seed for the session's word selection.
+ * @param players The store of the player profiles, nullptr to refuse NAME.
+ * @param leaderboard The leaderboard, nullptr to refuse TOP.
+ * @param journal Records the session's games, nullptr for none.
+ */
+GameSession::GameSession(std::shared_ptr<const DictionaryStore> dictionary, const std::uint64_t seed,
+                         std::shared_ptr<PlayerStore> players, std::shared_ptr<Leaderboard> leaderboard,
+                         std::shared_ptr<Journal> journal)
+	: dictionary(std::move(dictionary)), players(std::move(players)), leaderboard(std::move(leaderboard))
+{
+	engine.setSeed(seed);
+	engine.setJournal(std::move(journal));
+}
+
+/**
+ * Parses and executes one request.
+ *
+ * @param line The request, without the line terminator.
+ * @param reply Receives the reply line.
+ */
+void GameSession::handleLine(std::string_view line, std::string& reply)
+{
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+
+	const std::string_view command = nextToken(line);
+	const std::string_view argument = nextToken(line);
+
+	if (isKeyword(command, "guess"))
+	{
+		if (argument.size() != 1)
+		{
+			reply += "ERR GUESS takes a single letter\n";
+			return;
+		}
+		if (engine.status() == GameStatus::NOT_STARTED)
+		{
+			reply += "ERR no game, send NEW first\n";
+			return;
+		}
+		const GuessResult result = engine.guess(argument[0]);
+		if (engine.over() && result != GuessResult::GAME_OVER)
+		{
+			recordGame(engine.won(), engine.attemptsLeft(), difficulty);
+		}
+		appendState(GUESS_RESULT_NAMES[static_cast<std::size_t>(result)], reply);
+	}
+	else if (isKeyword(command, "new"))
+	{
+		WordDifficultyTypes requested = WordDifficultyTypes::MEDIUM;
+		if (isKeyword(argument, "easy"))
+		{
+			requested = WordDifficultyTypes::EASY;
+		}
+		else if (isKeyword(argument, "hard"))
+		{
+			requested = WordDifficultyTypes::HARD;
+		}
+		else if (!argument.empty() && !isKeyword(argument, "medium"))
+		{
+			reply += "ERR unknown difficulty\n";
+			return;
+		}
+
+		// A game given up for a new one counts as lost, or a player could dodge every loss
+		const bool abandoned = engine.status() == GameStatus::IN_PROGRESS;
+		const int attemptsLeft = engine.attemptsLeft();
+		engine.setDictionary(dictionary->snapshot());
+		if (!engine.newGame(requested))
+		{
+			reply += "ERR no word of that difficulty\n";
+			return;
+		}
+		if (abandoned)
+		{
+			recordGame(false, attemptsLeft, difficulty);
+		}
+		difficulty = requested;
+		appendState("NEW", reply);
+	}
+	else if (isKeyword(command, "state"))
+	{
+		appendState("STATE", reply);
+	}
+	else if (isKeyword(command, "name"))
+	{
+		if (!players)
+		{
+			reply += "ERR profiles are not kept\n";
+			return;
+		}
+		if (argument.empty() || argument.size() > PlayerStore::MAX_NAME_LENGTH)
+		{
+			reply += "ERR NAME takes a name of 1 to 64 characters\n";
+			return;
+		}
+		playerName = argument;
+		appendProfile(players->find(playerName).value_or(PlayerProfile{}), reply);
+	}
+	else if (isKeyword(command, "profile"))
+	{
+		if (playerName.empty())
+		{
+			reply += "ERR no player, send NAME first\n";
+			return;
+		}
+		appendProfile(players->find(playerName).value_or(PlayerProfile{}), reply);
+	}
+	else if (isKeyword(command, "top"))
+	{
+		if (!leaderboard)
+		{
+			reply += "ERR no leaderboard\n";
+			return;
+		}
+		std::size_t count = DEFAULT_TOP_COUNT;
+		if (!argument.empty())
+		{
+			const auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), count);
+			if (error != std::errc() || end != argument.data() + argument.size() || count == 0)
+			{
+				reply += "ERR TOP takes a positive count\n";
+				return;
+			}
+		}
+
+		const auto top = leaderboard->top();
+		count = std::min(count, top->size());
+		reply += "TOP ";
+		reply += std::to_string(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			reply += ' ';
+			reply += (*top)[i].name;
+			reply += ' ';
+			reply += std::to_string((*top)[i].score);
+		}
+		reply += '\n';
+	}
+	else if (isKeyword(command, "metrics"))
+	{
+		reply += "METRICS ";
+		reply += Metrics::snapshot().json();
+		reply += '\n';
+	}
+	else if (isKeyword(command, "quit"))
+	{
+		if (engine.status() == GameStatus::IN_PROGRESS)
+		{
+			recordGame(false, engine.attemptsLeft(), difficulty);
+		}
+		quit = true;
+		reply += "BYE\n";
+	}
+	else
+	{
+		reply += "ERR unknown command\n";
+	}
+}
+
+/**
+ * Ends the session, recording an unfinished game of a named player as lost
+ * unless QUIT did already.
+ */
+void GameSession::end()
+{
+	if (!quit && engine.status() == GameStatus::IN_PROGRESS)
+	{
+		recordGame(false, engine.attemptsLeft(), difficulty);
+	}
+	quit = true;
+}
+
+/**
+ * Records a game of a named player in the player store and submits the new
+ * score to the leaderboard. Games of an anonymous session are not kept.
+ *
+ * @param won True if the game was won.
+ * @param attemptsLeft The attempts left at the end of the game.
+ * @param gameDifficulty The difficulty of the game.
+ */
+void GameSession::recordGame(const bool won, const int attemptsLeft, const WordDifficultyTypes gameDifficulty)
+{
+	if (playerName.empty())
+	{
+		return;
+	}
+	const PlayerProfile profile = players->recordGame(playerName, won, attemptsLeft, gameDifficulty);
+	if (leaderboard)
+	{
+		leaderboard->submit(playerName, profile.score);
+	}
+}
+
+/**
+ * Appends `<result> <masked word> <attempts left> <status>`, and the word once the game is over.
+ *
+ * @param result The first word of the reply.
+ * @param reply Receives the reply line.
+ */
+void GameSession::appendState(const std::string_view result, std::string& reply) const
+{
+	reply += result;
+	reply += ' ';
+	if (engine.status() == GameStatus::NOT_STARTED)
+	{
+		reply += '-';
+	}
+	else
+	{
+		reply += engine.maskedWord();
+	}
+	reply += ' ';
+	reply += std::to_string(engine.attemptsLeft());
+	reply += ' ';
+	reply += GAME_STATUS_NAMES[static_cast<std::size_t>(engine.status())];
+	if (engine.over())
+	{
+		reply += ' ';
+		reply += engine.targetWord();
+	}
+	reply += '\n';
+}
+
+/**
+ * Appends `PLAYER <name> <level> <score> <wins> <losses>`.
+ *
+ * @param profile The player's profile.
+ * @param reply Receives the reply line.
+ */
+void GameSession::appendProfile(const PlayerProfile& profile, std::string& reply) const
+{
+	reply += "PLAYER ";
+	reply += playerName;
+	reply += ' ';
+	reply += std::to_string(profile.level);
+	reply += ' ';
+	reply += std::to_string(profile.score);
+	reply += ' ';
+	reply += std::to_string(profile.wins);
+	reply += ' ';
+	reply += std::to_string(profile.losses);
+	reply += '\n';
+}
@@ -0,0 +1,126 @@
+#include <GuessStrategy.h>
+
+namespace
+{
+	/**
+	 * @brief The letters of the alphabet from most to least frequent in English text.
+	 */
+	constexpr char ENGLISH_FREQUENCY_ORDER[] = "etaoinshrdlcumwfgypbvkjxqz";
+}
+
+/**
+ * The frequency order does not depend on the game, nothing to prepare.
+ */
+void FrequencyGuessStrategy::newGame(const GameEngine& /*game*/, std::uint64_t /*seed*/)
+{
+}
+
+/**
+ * Chooses the most frequent English letter that has not been guessed yet.
+ *
+ * @param game The game in progress.
+ * @return The next letter to guess.
+ */
+char FrequencyGuessStrategy::nextGuess(const GameEngine& game)
+{
+	for (const char letter : std::string_view(ENGLISH_FREQUENCY_ORDER))
+	{
+		if ((game.guessedLetters() & letterBit(letter)) == 0)
+		{
+			return letter;
+		}
+	}
+	return 'a';
+}
+
+/**
+ * Reseeds the strategy so every game's guesses are reproducible.
+ *
+ * @param seed The per-game seed.
+ */
+void RandomGuessStrategy::newGame(const GameEngine& /*game*/, const std::uint64_t seed)
+{
+	random.setSeed(seed);
+}
+
+/**
+ * Chooses a uniformly random letter among those not guessed yet.
+ *
+ * @param game The game in progress.
+ * @return The next letter to guess.
+ */
+char RandomGuessStrategy::nextGuess(const GameEngine& game)
+{
+	const LetterMask remaining = ALL_LETTERS_MASK & ~game.guessedLetters();
+	const int count = letterCount(remaining);
+	if (count == 0)
+	{
+		return 'a';
+	}
+
+	auto skip = static_cast<int>(random.below(static_cast<std::uint64_t>(count)));
+	for (char letter = 'a'; letter <= 'z'; ++letter)
+	{
+		if ((remaining & letterBit(letter)) != 0 && skip-- == 0)
+		{
+			return letter;
+		}
+	}
+	return 'a';
+}
+
+/**
+ * Starts the solver from every dictionary word of the target's length.
+ *
+ * @param game The game that was just started.
+ */
+void SolverGuessStrategy::newGame(const GameEngine& game, std::uint64_t /*seed*/)
+{
+	const auto& dictionary = game.getDictionary();
+	solver.reset(dictionary ? dictionary->wordsOfLength(game.targetWord().size()) : WordListView());
+}
+
+/**
+ * Narrows the candidates with the outcome of the previous guesses and asks the
+ * solver for the most informative letter.
+ *
+ * @param game The game in progress.
+ * @return The next letter to guess.
+ */
+char SolverGuessStrategy::nextGuess(const GameEngine& game)
+{
+	solver.update(game.maskedWord(), game.incorrectLetters());
+	const char letter = solver.bestGuess();
+	return letter != '\0' ? letter : fallback.nextGuess(game);
+}
+
+/**
+ * Looks up a built-in strategy by name.
+ *
+ * @param name The strategy name.
+ * @return A factory for the strategy, or an empty function for an unknown name.
+ */
+GuessStrategyFactory makeGuessStrategyFactory(const std::string& name)
+{
+	if (name == "frequency")
+	{
+		return [] { return std::make_unique<FrequencyGuessStrategy>(); };
+	}
+	if (name == "random")
+	{
+		return [] { return std::make_unique<RandomGuessStrategy>(); };
+	}
+	if (name == "solver")
+	{
+		return [] { return std::make_unique<SolverGuessStrategy>(); };
+	}
+	return {};
+}
+
+/**
+ * @return The names of the built-in strategies.
+ */
+std::vector<std::string> guessStrategyNames()
+{
+	return {"frequency", "random", "solver"};
+}
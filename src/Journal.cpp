@@ -0,0 +1,378 @@
+#include <Journal.h>
+#include <JournalFormat.h>
+#include <invalid_journal_exception.h>
+
+#include <atomic>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief Hands every thread the next record buffer in turn.
+	 */
+	std::atomic<std::size_t> nextShard{0};
+
+	/**
+	 * @return The index of the calling thread's record buffer, the same in every Journal.
+	 */
+	std::size_t shardIndex()
+	{
+		thread_local const std::size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % Journal::SHARD_COUNT;
+		return index;
+	}
+
+	/**
+	 * Appends an unsigned LEB128 varint.
+	 *
+	 * @param out Receives the encoding.
+	 * @param value The value.
+	 */
+	void appendVarint(std::string& out, std::uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<char>(value));
+	}
+
+	/**
+	 * Appends the bytes of a fixed-size integer.
+	 *
+	 * @param out Receives the bytes.
+	 * @param value The value.
+	 */
+	template <typename T>
+	void appendFixed(std::string& out, const T value)
+	{
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	/**
+	 * Reads an unsigned LEB128 varint.
+	 *
+	 * @param data The bytes, advanced past the varint.
+	 * @param value Receives the value.
+	 * @return False if the data ends inside the varint or it does not fit 64 bits.
+	 */
+	bool readVarint(std::string_view& data, std::uint64_t& value)
+	{
+		value = 0;
+		for (unsigned shift = 0; shift < 64 && !data.empty(); shift += 7)
+		{
+			const auto byte = static_cast<unsigned char>(data.front());
+			data.remove_prefix(1);
+			value |= std::uint64_t{byte & 0x7fU} << shift;
+			if ((byte & 0x80U) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Reads a fixed-size integer.
+	 *
+	 * @param data The bytes, advanced past the integer.
+	 * @param value Receives the value.
+	 * @return False if the data is too short.
+	 */
+	template <typename T>
+	bool readFixed(std::string_view& data, T& value)
+	{
+		if (data.size() < sizeof(value))
+		{
+			return false;
+		}
+		std::memcpy(&value, data.data(), sizeof(value));
+		data.remove_prefix(sizeof(value));
+		return true;
+	}
+
+	/**
+	 * @param duration A duration.
+	 * @return The duration in whole microseconds, 0 if negative.
+	 */
+	template <typename Duration>
+	std::uint64_t microseconds(const Duration duration)
+	{
+		const auto count = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+		return count > 0 ? static_cast<std::uint64_t>(count) : 0;
+	}
+}
+
+/**
+ * Opens the journal for appending and writes the header into a new or empty
+ * file. The records of an existing file are decoded like JournalReader does,
+ * and the file is cut back to the end of the last complete one.
+ *
+ * @param fileToWrite The journal file.
+ */
+Journal::Journal(std::filesystem::path fileToWrite) : path(std::move(fileToWrite))
+{
+	std::error_code error;
+	const auto existingSize = std::filesystem::file_size(path, error);
+	if (!error && existingSize > 0)
+	{
+		std::size_t validLength = 0;
+		{
+			JournalReader existing(path);
+			JournalGame game;
+			while (existing.next(game))
+			{
+			}
+			validLength = existing.validLength();
+		}
+		if (validLength < existingSize)
+		{
+			std::filesystem::resize_file(path, validLength, error);
+			if (error)
+			{
+				throw InvalidJournalException(path.string(), "damaged tail cannot be cut off");
+			}
+		}
+	}
+
+	file.open(path, std::ios::binary | std::ios::app);
+	if (!file.is_open())
+	{
+		throw InvalidJournalException(path.string(), "cannot be opened for writing");
+	}
+	if (error || existingSize == 0)
+	{
+		JournalFormat::Header header{};
+		std::memcpy(header.magic, JournalFormat::MAGIC, sizeof(header.magic));
+		header.version = JournalFormat::VERSION;
+		if (!write({reinterpret_cast<const char*>(&header), sizeof(header)}))
+		{
+			throw InvalidJournalException(path.string(), "could not be written");
+		}
+	}
+}
+
+/**
+ * Writes the buffered records. Errors are ignored, there is nobody left to tell.
+ */
+Journal::~Journal()
+{
+	for (Shard& shard : shards)
+	{
+		write(shard.records);
+	}
+}
+
+/**
+ * Appends a record to the calling thread's buffer and writes the buffer,
+ * outside its lock, once it is full.
+ *
+ * @param record A complete record.
+ */
+void Journal::append(const std::string_view record)
+{
+	Shard& shard = shards[shardIndex()];
+	std::string full;
+	{
+		const std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.records.append(record);
+		if (shard.records.size() < BUFFER_BYTES)
+		{
+			return;
+		}
+		full.reserve(BUFFER_BYTES + record.size());
+		full.swap(shard.records);
+	}
+	write(full);
+}
+
+/**
+ * Writes the records of every buffer.
+ */
+void Journal::flush()
+{
+	for (Shard& shard : shards)
+	{
+		std::string records;
+		{
+			const std::lock_guard<std::mutex> lock(shard.mutex);
+			records.swap(shard.records);
+		}
+		if (!write(records))
+		{
+			throw InvalidJournalException(path.string(), "could not be written");
+		}
+	}
+}
+
+/**
+ * Writes records to the file and flushes the stream.
+ *
+ * @param records Complete records.
+ * @return True if they were written.
+ */
+bool Journal::write(const std::string_view records)
+{
+	if (records.empty())
+	{
+		return true;
+	}
+	const std::lock_guard<std::mutex> lock(fileMutex);
+	file.write(records.data(), static_cast<std::streamsize>(records.size()));
+	file.flush();
+	return static_cast<bool>(file);
+}
+
+/**
+ * Starts recording a game: encodes everything before the guesses and takes
+ * the start time.
+ *
+ * @param seed The seed the engine was last given.
+ * @param fingerprint The fingerprint of the word's dictionary.
+ * @param difficulty The WordDifficultyTypes value, 0 for none.
+ * @param wordNumber The number of the word in its dictionary, if any.
+ * @param word The word, stored only without a word number.
+ */
+void GameRecord::start(const std::uint64_t seed, const std::uint32_t fingerprint, const std::uint8_t difficulty,
+                       const std::optional<std::uint32_t> wordNumber, const std::string_view word)
+{
+	head.clear();
+	guesses.clear();
+	guessCount = 0;
+	recording = true;
+
+	appendFixed(head, seed);
+	appendFixed(head, fingerprint);
+	appendFixed(head, difficulty);
+	outcomeOffset = head.size();
+	appendFixed(head, static_cast<std::uint8_t>(GameStatus::IN_PROGRESS));
+	if (wordNumber)
+	{
+		appendVarint(head, std::uint64_t{*wordNumber} + 1);
+	}
+	else
+	{
+		appendVarint(head, 0);
+		appendVarint(head, word.size());
+		head.append(word);
+	}
+	appendVarint(head, microseconds(std::chrono::system_clock::now().time_since_epoch()));
+	lastEvent = std::chrono::steady_clock::now();
+}
+
+/**
+ * Records a guess with the time since the previous event.
+ *
+ * @param letter The guessed character.
+ */
+void GameRecord::guess(const char letter)
+{
+	const auto now = std::chrono::steady_clock::now();
+	guesses.push_back(letter);
+	appendVarint(guesses, microseconds(now - lastEvent));
+	lastEvent = now;
+	++guessCount;
+}
+
+/**
+ * Completes the record with the outcome and the guesses and appends it.
+ *
+ * @param journal The journal.
+ * @param outcome WON, LOST, or IN_PROGRESS for an abandoned game.
+ */
+void GameRecord::finish(Journal& journal, const GameStatus outcome)
+{
+	head[outcomeOffset] = static_cast<char>(outcome);
+	std::string count;
+	appendVarint(count, guessCount);
+
+	record.clear();
+	appendVarint(record, head.size() + count.size() + guesses.size());
+	record += head;
+	record += count;
+	record += guesses;
+	journal.append(record);
+	recording = false;
+}
+
+/**
+ * Maps the journal and checks its header.
+ *
+ * @param fileToRead The journal file.
+ */
+JournalReader::JournalReader(const std::filesystem::path& fileToRead) : journal(fileToRead)
+{
+	JournalFormat::Header header{};
+	if (journal.size() >= sizeof(header))
+	{
+		std::memcpy(&header, journal.contents().data(), sizeof(header));
+	}
+	if (std::memcmp(header.magic, JournalFormat::MAGIC, sizeof(header.magic)) != 0 ||
+	    header.version != JournalFormat::VERSION)
+	{
+		throw InvalidJournalException(fileToRead.string(), "is not a journal of this version");
+	}
+	offset = sizeof(header);
+}
+
+/**
+ * Decodes the next record. The payload must be complete and consumed exactly,
+ * otherwise reading stops there.
+ *
+ * @param game Receives the game.
+ * @return False at the end of the journal or at a damaged record.
+ */
+bool JournalReader::next(JournalGame& game)
+{
+	std::string_view data = journal.contents().substr(offset);
+	std::uint64_t length = 0;
+	if (stopped || data.empty() || !readVarint(data, length) || length > data.size())
+	{
+		stopped = true;
+		return false;
+	}
+	const std::size_t recordEnd = journal.size() - data.size() + static_cast<std::size_t>(length);
+	std::string_view payload = data.substr(0, static_cast<std::size_t>(length));
+
+	std::uint8_t outcome = 0;
+	std::uint64_t word = 0;
+	std::uint64_t guessCount = 0;
+	bool valid = readFixed(payload, game.seed) && readFixed(payload, game.fingerprint) &&
+	             readFixed(payload, game.difficulty) && readFixed(payload, outcome) && readVarint(payload, word);
+	game.wordNumber.reset();
+	game.word.clear();
+	if (valid && word > 0)
+	{
+		game.wordNumber = static_cast<std::uint32_t>(word - 1);
+	}
+	else if (valid)
+	{
+		std::uint64_t wordLength = 0;
+		valid = readVarint(payload, wordLength) && wordLength <= payload.size();
+		if (valid)
+		{
+			game.word.assign(payload.substr(0, static_cast<std::size_t>(wordLength)));
+			payload.remove_prefix(static_cast<std::size_t>(wordLength));
+		}
+	}
+	valid = valid && readVarint(payload, game.startMicros) && readVarint(payload, guessCount) &&
+	        guessCount <= payload.size();
+
+	game.guesses.clear();
+	for (std::uint64_t i = 0; valid && i < guessCount; ++i)
+	{
+		JournalGuess guess;
+		valid = readFixed(payload, guess.letter) && readVarint(payload, guess.delayMicros);
+		game.guesses.push_back(guess);
+	}
+	if (!valid || !payload.empty())
+	{
+		stopped = true;
+		return false;
+	}
+
+	game.outcome = static_cast<GameStatus>(outcome);
+	offset = recordEnd;
+	return true;
+}
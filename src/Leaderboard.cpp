@@ -0,0 +1,159 @@
+#include <Leaderboard.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief Hands every thread the next submission buffer in turn.
+	 */
+	std::atomic<std::size_t> nextShard{0};
+
+	/**
+	 * @return The index of the calling thread's submission buffer, the same in every Leaderboard.
+	 */
+	std::size_t shardIndex()
+	{
+		thread_local const std::size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % Leaderboard::SHARD_COUNT;
+		return index;
+	}
+}
+
+/**
+ * Creates an empty leaderboard and starts the background merge.
+ *
+ * @param capacity The number of players ranked, at least 1.
+ * @param mergeInterval How often submitted scores are merged, 0 to merge on refresh() only.
+ */
+Leaderboard::Leaderboard(const std::size_t capacity, const std::chrono::milliseconds mergeInterval) :
+	limit(std::max<std::size_t>(capacity, 1)), mergeInterval(mergeInterval),
+	published(std::make_shared<const LeaderboardSnapshot>())
+{
+	if (mergeInterval.count() > 0)
+	{
+		merger = std::thread(&Leaderboard::mergeLoop, this);
+	}
+}
+
+/**
+ * Stops the background merge. Scores not merged yet are dropped.
+ */
+Leaderboard::~Leaderboard()
+{
+	{
+		const std::lock_guard<std::mutex> lock(stopMutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	if (merger.joinable())
+	{
+		merger.join();
+	}
+}
+
+/**
+ * Appends the score to the calling thread's buffer, unless it is below the
+ * lowest score of a full leaderboard, which takes a single relaxed load.
+ *
+ * @param name The player's name.
+ * @param score The score.
+ */
+void Leaderboard::submit(const std::string_view name, const std::int64_t score)
+{
+	if (score < threshold.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	Shard& shard = shards[shardIndex()];
+	const std::lock_guard<std::mutex> lock(shard.mutex);
+	shard.submissions.push_back({std::string(name), score});
+}
+
+/**
+ * Takes the submissions of every buffer, holding each lock only for a swap,
+ * and applies them to the ranking. A ranked player moves when their score
+ * improves; anyone else enters by beating the lowest ranked player, who drops
+ * out of the ranking once it is full. The result is published when it changed.
+ */
+void Leaderboard::refresh()
+{
+	const std::lock_guard<std::mutex> lock(mergeMutex);
+	bool changed = false;
+	std::vector<LeaderboardEntry> submissions;
+	for (Shard& shard : shards)
+	{
+		{
+			const std::lock_guard<std::mutex> shardLock(shard.mutex);
+			submissions.swap(shard.submissions);
+		}
+
+		for (LeaderboardEntry& entry : submissions)
+		{
+			const auto found = ranked.find(entry.name);
+			if (found != ranked.end())
+			{
+				if (entry.score <= found->second)
+				{
+					continue;
+				}
+				ranking.erase({entry.name, found->second});
+				found->second = entry.score;
+			}
+			else
+			{
+				if (ranking.size() == limit)
+				{
+					const auto lowest = std::prev(ranking.end());
+					if (!(entry < *lowest))
+					{
+						continue;
+					}
+					ranked.erase(lowest->name);
+					ranking.erase(lowest);
+				}
+				ranked.emplace(entry.name, entry.score);
+			}
+			ranking.insert(std::move(entry));
+			changed = true;
+		}
+		submissions.clear();
+	}
+
+	if (!changed)
+	{
+		return;
+	}
+	if (ranking.size() == limit)
+	{
+		threshold.store(std::prev(ranking.end())->score, std::memory_order_relaxed);
+	}
+	std::atomic_store(&published, std::shared_ptr<const LeaderboardSnapshot>(
+		std::make_shared<LeaderboardSnapshot>(ranking.begin(), ranking.end())));
+}
+
+/**
+ * Retrieves the published leaderboard with an atomic load.
+ *
+ * @return The leaderboard as of the last merge, best first.
+ */
+std::shared_ptr<const LeaderboardSnapshot> Leaderboard::top() const
+{
+	return std::atomic_load(&published);
+}
+
+/**
+ * Calls refresh() every merge interval until the destructor sets `stopping`.
+ */
+void Leaderboard::mergeLoop()
+{
+	std::unique_lock<std::mutex> lock(stopMutex);
+	while (!stopping)
+	{
+		wake.wait_for(lock, mergeInterval, [this] { return stopping; });
+		lock.unlock();
+		refresh();
+		lock.lock();
+	}
+}
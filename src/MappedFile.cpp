@@ -0,0 +1,127 @@
+#include <MappedFile.h>
+#include <file_not_found_exception.h>
+
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Maps the given file into memory.
+ *
+ * An empty file produces an empty mapping.
+ *
+ * @param fileToMap Path to the file to map.
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ */
+MappedFile::MappedFile(const std::filesystem::path& fileToMap)
+{
+#ifdef _WIN32
+	std::ifstream file(fileToMap, std::ios::binary);
+	if (!file.is_open())
+	{
+		throw FileNotFoundException(fileToMap.string());
+	}
+	buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	address = buffer.data();
+	length = buffer.size();
+#else
+	const int fd = ::open(fileToMap.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		throw FileNotFoundException(fileToMap.string());
+	}
+
+	struct stat status{};
+	if (::fstat(fd, &status) != 0)
+	{
+		::close(fd);
+		throw FileNotFoundException(fileToMap.string());
+	}
+
+	if (status.st_size > 0)
+	{
+		void* mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			::close(fd);
+			throw FileNotFoundException(fileToMap.string());
+		}
+
+		// The words are scanned front to back, let the kernel read ahead aggressively
+		::madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+		address = static_cast<const char*>(mapping);
+		length = static_cast<std::size_t>(status.st_size);
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	::close(fd);
+#endif
+}
+
+/**
+ * Releases the mapping.
+ */
+MappedFile::~MappedFile()
+{
+	release();
+}
+
+/**
+ * Transfers the mapping from another instance, leaving it empty.
+ *
+ * @param other The instance to take the mapping from.
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+/**
+ * Releases the current mapping and takes over the mapping of another instance.
+ *
+ * @param other The instance to take the mapping from.
+ * @return This instance.
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+#ifdef _WIN32
+		// Moving a std::string may relocate small strings, so take the address afterwards
+		buffer = std::move(other.buffer);
+		address = buffer.data();
+#else
+		address = other.address;
+#endif
+		length = other.length;
+		other.address = nullptr;
+		other.length = 0;
+	}
+	return *this;
+}
+
+/**
+ * Releases the mapping, if any, and resets the instance to empty.
+ */
+void MappedFile::release() noexcept
+{
+#ifdef _WIN32
+	buffer.clear();
+#else
+	if (address != nullptr)
+	{
+		::munmap(const_cast<char*>(address), length);
+	}
+#endif
+	address = nullptr;
+	length = 0;
+}
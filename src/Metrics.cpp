@@ -0,0 +1,387 @@
+#include <Metrics.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief The name and help text of a metric in the exports.
+	 */
+	struct MetricDescription
+	{
+		const char* name;
+		const char* help;
+	};
+
+	/**
+	 * @brief The counters, in MetricCounter order.
+	 */
+	constexpr std::array<MetricDescription, METRIC_COUNTER_COUNT> COUNTERS = {{
+		{"games_started", "Games started."},
+		{"games_won", "Games won."},
+		{"games_lost", "Games lost."},
+		{"guesses", "Characters guessed in games in progress, letters or not."},
+		{"dictionary_loads", "Dictionaries loaded or reloaded."},
+	}};
+
+	/**
+	 * @brief The histograms, in MetricHistogram order.
+	 */
+	constexpr std::array<MetricDescription, METRIC_HISTOGRAM_COUNT> HISTOGRAMS = {{
+		{"dictionary_load", "Time to load a dictionary."},
+		{"word_pick", "Time to pick a word and set up a game."},
+		{"guess", "Time to apply a guess."},
+		{"render", "Time to render and write a console frame."},
+	}};
+
+	/**
+	 * @brief The Prometheus bucket bounds in nanoseconds, 1-2.5-5 steps from 100 ns to 10 s.
+	 */
+	constexpr std::array<std::uint64_t, 25> EXPORT_BOUNDS = {
+		100, 250, 500, 1'000, 2'500, 5'000, 10'000, 25'000, 50'000,
+		100'000, 250'000, 500'000, 1'000'000, 2'500'000, 5'000'000, 10'000'000, 25'000'000, 50'000'000,
+		100'000'000, 250'000'000, 500'000'000, 1'000'000'000, 2'500'000'000, 5'000'000'000, 10'000'000'000,
+	};
+
+	/**
+	 * @brief Adds to a value only the calling thread writes.
+	 *
+	 * @param value The value.
+	 * @param amount The amount to add.
+	 */
+	void addTo(std::atomic<std::uint64_t>& value, const std::uint64_t amount)
+	{
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief One histogram of a shard.
+	 */
+	struct ShardHistogram
+	{
+		std::array<std::atomic<std::uint64_t>, HistogramSnapshot::BUCKET_COUNT> buckets{};
+		std::atomic<std::uint64_t> count{0};
+		std::atomic<std::uint64_t> sum{0};
+		std::atomic<std::uint64_t> max{0};
+	};
+
+	/**
+	 * @brief The metrics recorded by one thread.
+	 */
+	struct Shard
+	{
+		std::array<std::atomic<std::uint64_t>, METRIC_COUNTER_COUNT> counters{};
+		std::array<ShardHistogram, METRIC_HISTOGRAM_COUNT> histograms{};
+	};
+
+	/**
+	 * @brief Every shard ever handed out, and those whose thread has exited.
+	 */
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::vector<Shard*> unused;
+	};
+
+	/**
+	 * @return The registry. Never destroyed, so threads may still record while the process exits.
+	 */
+	Registry& registry()
+	{
+		static Registry* const instance = new Registry();
+		return *instance;
+	}
+
+	/**
+	 * @brief Holds the shard of a thread and gives it back when the thread exits.
+	 */
+	class ShardLease
+	{
+	public:
+		ShardLease()
+		{
+			Registry& shared = registry();
+			const std::lock_guard<std::mutex> lock(shared.mutex);
+			if (shared.unused.empty())
+			{
+				shared.shards.push_back(std::make_unique<Shard>());
+				shard = shared.shards.back().get();
+			}
+			else
+			{
+				shard = shared.unused.back();
+				shared.unused.pop_back();
+			}
+		}
+
+		~ShardLease()
+		{
+			Registry& shared = registry();
+			const std::lock_guard<std::mutex> lock(shared.mutex);
+			shared.unused.push_back(shard);
+		}
+
+		ShardLease(const ShardLease& other) = delete;
+		ShardLease& operator=(const ShardLease& other) = delete;
+
+		Shard* shard{nullptr};
+	};
+
+	/**
+	 * @return The shard of the calling thread, leased on its first call.
+	 */
+	Shard* leaseShard()
+	{
+		thread_local ShardLease lease;
+		return lease.shard;
+	}
+
+	/**
+	 * @return The shard of the calling thread.
+	 */
+	Shard& localShard()
+	{
+		// A trivially constructed thread_local needs no guard on every access
+		thread_local Shard* shard = nullptr;
+		if (shard == nullptr)
+		{
+			shard = leaseShard();
+		}
+		return *shard;
+	}
+}
+
+/**
+ * Takes the exponent of the value for the upper bits of the index and the
+ * next log2(SUB_BUCKETS) bits of the value for the lower ones. Values below
+ * SUB_BUCKETS have buckets of their own.
+ *
+ * @param value The value in nanoseconds.
+ * @return The bucket index.
+ */
+std::size_t HistogramSnapshot::bucketOf(const std::uint64_t value)
+{
+	if (value < SUB_BUCKETS)
+	{
+		return static_cast<std::size_t>(value);
+	}
+	const auto exponent = static_cast<unsigned>(63 - __builtin_clzll(value));
+	const unsigned shift = exponent - SUB_BUCKET_BITS;
+	return (shift + 1) * SUB_BUCKETS + static_cast<std::size_t>((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+/**
+ * Inverts bucketOf() for the first value of a bucket.
+ *
+ * @param bucket The bucket index.
+ * @return The smallest value of the bucket, the largest 64 bit value past the last bucket.
+ */
+std::uint64_t HistogramSnapshot::lowerBound(const std::size_t bucket)
+{
+	if (bucket < SUB_BUCKETS)
+	{
+		return bucket;
+	}
+	if (bucket >= BUCKET_COUNT)
+	{
+		return std::numeric_limits<std::uint64_t>::max();
+	}
+	const std::size_t shift = bucket / SUB_BUCKETS - 1;
+	return (SUB_BUCKETS | (bucket & (SUB_BUCKETS - 1))) << shift;
+}
+
+/**
+ * Walks the buckets until the requested share of the values is covered.
+ *
+ * @param quantile The quantile, between 0 and 1.
+ * @return The estimated value in nanoseconds.
+ */
+std::uint64_t HistogramSnapshot::valueAt(const double quantile) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+	const auto rank = std::max<std::uint64_t>(
+		1, static_cast<std::uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count))));
+
+	std::uint64_t seen = 0;
+	for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+	{
+		seen += buckets[bucket];
+		if (seen >= rank)
+		{
+			return std::min(lowerBound(bucket + 1) - 1, max);
+		}
+	}
+	return max;
+}
+
+/**
+ * Sums the buckets whose largest value does not exceed the bound.
+ *
+ * @param bound The bound in nanoseconds.
+ * @return The number of values.
+ */
+std::uint64_t HistogramSnapshot::countAtOrBelow(const std::uint64_t bound) const
+{
+	std::uint64_t total = 0;
+	for (std::size_t bucket = 0; bucket < BUCKET_COUNT && lowerBound(bucket + 1) - 1 <= bound; ++bucket)
+	{
+		total += buckets[bucket];
+	}
+	return total;
+}
+
+/**
+ * Writes every counter and histogram with HELP and TYPE lines. Durations are
+ * converted to seconds, as Prometheus expects.
+ *
+ * @return The exposition.
+ */
+std::string MetricsSnapshot::prometheus() const
+{
+	std::ostringstream out;
+	for (std::size_t i = 0; i < COUNTERS.size(); ++i)
+	{
+		const std::string name = std::string("hangman_") + COUNTERS[i].name + "_total";
+		out << "# HELP " << name << ' ' << COUNTERS[i].help << '\n'
+		    << "# TYPE " << name << " counter\n"
+		    << name << ' ' << counters[i] << '\n';
+	}
+	for (std::size_t i = 0; i < HISTOGRAMS.size(); ++i)
+	{
+		const std::string name = std::string("hangman_") + HISTOGRAMS[i].name + "_duration_seconds";
+		const HistogramSnapshot& histogram = histograms[i];
+		out << "# HELP " << name << ' ' << HISTOGRAMS[i].help << '\n'
+		    << "# TYPE " << name << " histogram\n";
+		for (const std::uint64_t bound : EXPORT_BOUNDS)
+		{
+			out << name << "_bucket{le=\"" << static_cast<double>(bound) * 1e-9 << "\"} "
+			    << histogram.countAtOrBelow(bound) << '\n';
+		}
+		out << name << "_bucket{le=\"+Inf\"} " << histogram.count << '\n'
+		    << name << "_sum " << static_cast<double>(histogram.sum) * 1e-9 << '\n'
+		    << name << "_count " << histogram.count << '\n';
+	}
+	return out.str();
+}
+
+/**
+ * Writes the counters and a summary of every histogram on one line.
+ *
+ * @return The JSON text.
+ */
+std::string MetricsSnapshot::json() const
+{
+	std::ostringstream out;
+	out << "{\"counters\":{";
+	for (std::size_t i = 0; i < COUNTERS.size(); ++i)
+	{
+		out << (i == 0 ? "" : ",") << '"' << COUNTERS[i].name << "\":" << counters[i];
+	}
+	out << "},\"histograms\":{";
+	for (std::size_t i = 0; i < HISTOGRAMS.size(); ++i)
+	{
+		const HistogramSnapshot& histogram = histograms[i];
+		out << (i == 0 ? "" : ",") << '"' << HISTOGRAMS[i].name << "\":{\"count\":" << histogram.count
+		    << ",\"sum_ns\":" << histogram.sum << ",\"max_ns\":" << histogram.max
+		    << ",\"p50_ns\":" << histogram.valueAt(0.5) << ",\"p90_ns\":" << histogram.valueAt(0.9)
+		    << ",\"p99_ns\":" << histogram.valueAt(0.99) << ",\"p999_ns\":" << histogram.valueAt(0.999) << '}';
+	}
+	out << "}}";
+	return out.str();
+}
+
+/**
+ * Adds to the counter in the calling thread's shard.
+ *
+ * @param counter The counter.
+ * @param amount The amount to add.
+ */
+void Metrics::add(const MetricCounter counter, const std::uint64_t amount)
+{
+	addTo(localShard().counters[static_cast<std::size_t>(counter)], amount);
+}
+
+/**
+ * Records the duration in the calling thread's shard.
+ *
+ * @param histogram The histogram.
+ * @param duration The duration.
+ */
+void Metrics::record(const MetricHistogram histogram, const std::chrono::nanoseconds duration)
+{
+	if (!enabled())
+	{
+		return;
+	}
+	const auto value = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+	ShardHistogram& target = localShard().histograms[static_cast<std::size_t>(histogram)];
+	addTo(target.buckets[HistogramSnapshot::bucketOf(value)], 1);
+	addTo(target.count, 1);
+	addTo(target.sum, value);
+	if (value > target.max.load(std::memory_order_relaxed))
+	{
+		target.max.store(value, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * Counts down a per-thread budget, so the sampled calls are spread evenly over
+ * every thread's operations.
+ *
+ * @return True if the next operation should be timed.
+ */
+bool Metrics::sampleDue()
+{
+	thread_local std::uint32_t untilNextSample = 0;
+	if (untilNextSample == 0)
+	{
+		untilNextSample = HOT_PATH_SAMPLE_INTERVAL - 1;
+		return true;
+	}
+	--untilNextSample;
+	return false;
+}
+
+/**
+ * Sums every shard under the registry lock, which only keeps threads from
+ * starting or stopping to record meanwhile.
+ *
+ * @return The current values.
+ */
+MetricsSnapshot Metrics::snapshot()
+{
+	MetricsSnapshot result;
+	Registry& shared = registry();
+	const std::lock_guard<std::mutex> lock(shared.mutex);
+	for (const auto& shard : shared.shards)
+	{
+		for (std::size_t i = 0; i < METRIC_COUNTER_COUNT; ++i)
+		{
+			result.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+		}
+		for (std::size_t i = 0; i < METRIC_HISTOGRAM_COUNT; ++i)
+		{
+			const ShardHistogram& source = shard->histograms[i];
+			HistogramSnapshot& target = result.histograms[i];
+			for (std::size_t bucket = 0; bucket < HistogramSnapshot::BUCKET_COUNT; ++bucket)
+			{
+				target.buckets[bucket] += source.buckets[bucket].load(std::memory_order_relaxed);
+			}
+			target.count += source.count.load(std::memory_order_relaxed);
+			target.sum += source.sum.load(std::memory_order_relaxed);
+			target.max = std::max(target.max, source.max.load(std::memory_order_relaxed));
+		}
+	}
+	return result;
+}
@@ -0,0 +1,194 @@
+#include <PatternIndex.h>
+#include <WordIndex.h>
+
+#include <algorithm>
+
+namespace
+{
+	/**
+	 * @brief The number of letters, and of bitsets per position.
+	 */
+	constexpr std::size_t LETTERS = 26;
+
+	/**
+	 * @param c A character.
+	 * @return The letter's number, 0 for 'a' in either case, or LETTERS if the character is not a letter.
+	 */
+	std::size_t letterNumber(const char c)
+	{
+		return letterBit(c) != 0 ? static_cast<std::size_t>((c | 0x20) - 'a') : LETTERS;
+	}
+
+	/**
+	 * @param block A bitset block.
+	 * @return The number of bits set in the block.
+	 */
+	std::size_t bitCount(const std::uint64_t block)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<std::size_t>(__builtin_popcountll(block));
+#else
+		std::size_t total = 0;
+		for (std::uint64_t rest = block; rest != 0; rest &= rest - 1)
+		{
+			++total;
+		}
+		return total;
+#endif
+	}
+}
+
+/**
+ * Indexes a list of same-length words: every word sets its bit in the bitset
+ * of each of its letters at its position and in the "contains" bitset of each
+ * of its letters.
+ *
+ * @param words The words, as produced by WordIndex::wordsOfLength.
+ */
+PatternIndex::PatternIndex(const WordListView& words)
+	: first(words.begin()), count(words.size()), length(words.empty() ? 0 : words[0].size()),
+	  blocks((words.size() + 63) / 64), bits((length + 1) * LETTERS * blocks, 0)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const std::string_view word = words[i];
+		const std::size_t block = i / 64;
+		const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+		for (std::size_t position = 0; position < std::min(word.size(), length); ++position)
+		{
+			const std::size_t letter = letterNumber(word[position]);
+			if (letter == LETTERS)
+			{
+				continue;
+			}
+			bits[(position * LETTERS + letter) * blocks + block] |= bit;
+			bits[(length * LETTERS + letter) * blocks + block] |= bit;
+		}
+	}
+}
+
+/**
+ * Finds the words consistent with a game state. The operand bitsets are
+ * gathered first, then combined CHUNK_BLOCKS blocks at a time, so that every
+ * operand streams through once while the chunk of the result stays in cache.
+ *
+ * @param pattern The masked word, with '_' for every hidden letter.
+ * @param excluded The letters the words must not contain.
+ * @param matches Receives blockCount() blocks with the bit of every matching word set.
+ * @return The number of matching words.
+ */
+std::size_t PatternIndex::match(const std::string_view pattern, const LetterMask excluded,
+                                std::vector<std::uint64_t>& matches) const
+{
+	matches.assign(blocks, 0);
+	if (pattern.size() != length)
+	{
+		return 0;
+	}
+
+	std::vector<const std::uint64_t*> required;
+	std::vector<const std::uint64_t*> forbidden;
+	LetterMask revealed = 0;
+	for (std::size_t position = 0; position < length; ++position)
+	{
+		if (pattern[position] == '_')
+		{
+			continue;
+		}
+		const std::size_t letter = letterNumber(pattern[position]);
+		if (letter == LETTERS)
+		{
+			return 0;
+		}
+		revealed |= letterBit(pattern[position]);
+		required.push_back(row(position * LETTERS + letter));
+	}
+	for (std::size_t letter = 0; letter < LETTERS; ++letter)
+	{
+		if (((revealed >> letter) & 1) == 0)
+		{
+			continue;
+		}
+		// A hidden position cannot hold a revealed letter, or it would have been shown
+		for (std::size_t position = 0; position < length; ++position)
+		{
+			if (pattern[position] == '_')
+			{
+				forbidden.push_back(row(position * LETTERS + letter));
+			}
+		}
+	}
+	for (std::size_t letter = 0; letter < LETTERS; ++letter)
+	{
+		if (((excluded >> letter) & 1) != 0)
+		{
+			forbidden.push_back(row(length * LETTERS + letter));
+		}
+	}
+
+	std::uint64_t* const result = matches.data();
+	for (std::size_t start = 0; start < blocks; start += CHUNK_BLOCKS)
+	{
+		const std::size_t end = std::min(blocks, start + CHUNK_BLOCKS);
+		if (required.empty())
+		{
+			std::fill(result + start, result + end, ~std::uint64_t{0});
+		}
+		else
+		{
+			std::copy(required.front() + start, required.front() + end, result + start);
+		}
+		for (std::size_t operand = 1; operand < required.size(); ++operand)
+		{
+			const std::uint64_t* const bitset = required[operand];
+			for (std::size_t i = start; i < end; ++i)
+			{
+				result[i] &= bitset[i];
+			}
+		}
+		for (const std::uint64_t* const bitset : forbidden)
+		{
+			for (std::size_t i = start; i < end; ++i)
+			{
+				result[i] &= ~bitset[i];
+			}
+		}
+	}
+	// Only an all-ones start sets the bits past the last word
+	if (required.empty() && count % 64 != 0)
+	{
+		result[blocks - 1] &= (std::uint64_t{1} << (count % 64)) - 1;
+	}
+
+	std::size_t total = 0;
+	for (std::size_t i = 0; i < blocks; ++i)
+	{
+		total += bitCount(result[i]);
+	}
+	return total;
+}
+
+/**
+ * Retrieves the words holding a letter at a position.
+ *
+ * @param position The position, less than wordLength().
+ * @param letter The letter, in either case.
+ * @return blockCount() blocks, or nullptr if the character is not a letter.
+ */
+const std::uint64_t* PatternIndex::positionBits(const std::size_t position, const char letter) const
+{
+	const std::size_t number = letterNumber(letter);
+	return number == LETTERS ? nullptr : row(position * LETTERS + number);
+}
+
+/**
+ * Retrieves the words containing a letter.
+ *
+ * @param letter The letter, in either case.
+ * @return blockCount() blocks, or nullptr if the character is not a letter.
+ */
+const std::uint64_t* PatternIndex::containsBits(const char letter) const
+{
+	const std::size_t number = letterNumber(letter);
+	return number == LETTERS ? nullptr : row(length * LETTERS + number);
+}
@@ -0,0 +1,774 @@
+#include <PlayerStore.h>
+#include <PlayerStoreFormat.h>
+#include <MappedFile.h>
+#include <RandomEngine.h>
+#include <player_store_exception.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/**
+	 * Computes the checksum of a record.
+	 *
+	 * @param record The fixed-size part, its checksum field is ignored.
+	 * @param name The name following it.
+	 * @return The FNV-1a hash of both.
+	 */
+	std::uint32_t checksumOf(PlayerStoreFormat::Record record, const std::string_view name)
+	{
+		record.checksum = 0;
+		std::uint32_t hash = 2166136261U;
+		const auto mix = [&hash](const char* data, const std::size_t size) {
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619U;
+			}
+		};
+		mix(reinterpret_cast<const char*>(&record), sizeof(record));
+		mix(name.data(), name.size());
+		return hash;
+	}
+
+	/**
+	 * Appends the record of a profile.
+	 *
+	 * @param out Receives the record.
+	 * @param name The player's name.
+	 * @param profile The profile.
+	 */
+	void encodeRecord(std::string& out, const std::string_view name, const PlayerProfile& profile)
+	{
+		PlayerStoreFormat::Record record{};
+		record.nameLength = static_cast<std::uint32_t>(name.size());
+		record.level = profile.level;
+		record.wins = profile.wins;
+		record.losses = profile.losses;
+		record.score = profile.score;
+		record.checksum = checksumOf(record, name);
+		out.append(reinterpret_cast<const char*>(&record), sizeof(record));
+		out.append(name);
+	}
+
+	/**
+	 * Reads the record at an offset, if it is complete and intact.
+	 *
+	 * @param data The file contents.
+	 * @param offset The start of the record, advanced past it on success.
+	 * @param name Receives the name, pointing into data.
+	 * @param profile Receives the profile.
+	 * @return False if the record is truncated or fails its checksum.
+	 */
+	bool decodeRecord(const std::string_view data, std::uint64_t& offset, std::string_view& name,
+	                  PlayerProfile& profile)
+	{
+		PlayerStoreFormat::Record record{};
+		if (data.size() - offset < sizeof(record))
+		{
+			return false;
+		}
+		std::memcpy(&record, data.data() + offset, sizeof(record));
+		if (record.nameLength == 0 || record.nameLength > PlayerStore::MAX_NAME_LENGTH ||
+		    data.size() - offset - sizeof(record) < record.nameLength)
+		{
+			return false;
+		}
+		name = data.substr(offset + sizeof(record), record.nameLength);
+		if (record.checksum != checksumOf(record, name))
+		{
+			return false;
+		}
+		profile.level = record.level;
+		profile.wins = record.wins;
+		profile.losses = record.losses;
+		profile.score = record.score;
+		offset += sizeof(record) + record.nameLength;
+		return true;
+	}
+
+	/**
+	 * Opens a file for writing, creating it if needed.
+	 *
+	 * @param fileToOpen The file.
+	 * @param truncate True to empty the file, false to append to it.
+	 * @return The descriptor.
+	 * @throws PlayerStoreException if the file cannot be opened.
+	 */
+	int openFile(const std::filesystem::path& fileToOpen, const bool truncate)
+	{
+#ifdef _WIN32
+		const int fd = ::_wopen(fileToOpen.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : _O_APPEND),
+		                        _S_IREAD | _S_IWRITE);
+#else
+		const int fd = ::open(fileToOpen.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND), 0644);
+#endif
+		if (fd < 0)
+		{
+			throw PlayerStoreException(fileToOpen.string(), "cannot be opened for writing");
+		}
+		return fd;
+	}
+
+	/**
+	 * Writes a whole buffer, retrying short writes.
+	 *
+	 * @param fd The descriptor.
+	 * @param data The bytes to write.
+	 * @return True if every byte was written.
+	 */
+	bool writeAll(const int fd, std::string_view data)
+	{
+		while (!data.empty())
+		{
+#ifdef _WIN32
+			const int written = ::_write(fd, data.data(), static_cast<unsigned>(std::min<std::size_t>(data.size(), 1U << 30)));
+#else
+			const ssize_t written = ::write(fd, data.data(), data.size());
+			if (written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+#endif
+			if (written <= 0)
+			{
+				return false;
+			}
+			data.remove_prefix(static_cast<std::size_t>(written));
+		}
+		return true;
+	}
+
+	/**
+	 * Writes a buffer at an offset without moving the position of appends.
+	 *
+	 * @param fd The descriptor.
+	 * @param offset The offset in the file.
+	 * @param data The bytes to write.
+	 * @return True if every byte was written.
+	 */
+	bool writeAt(const int fd, const std::uint64_t offset, const std::string_view data)
+	{
+#ifdef _WIN32
+		return ::_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) >= 0 && writeAll(fd, data);
+#else
+		return ::pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset)) == static_cast<ssize_t>(data.size());
+#endif
+	}
+
+	/**
+	 * Makes the data written to a file durable.
+	 *
+	 * @param fd The descriptor.
+	 * @return True on success.
+	 */
+	bool syncFile(const int fd)
+	{
+#if defined(_WIN32)
+		return ::_commit(fd) == 0;
+#elif defined(__linux__)
+		return ::fdatasync(fd) == 0;
+#else
+		return ::fsync(fd) == 0;
+#endif
+	}
+
+	/**
+	 * Cuts a file to a length.
+	 *
+	 * @param fd The descriptor.
+	 * @param length The new length.
+	 * @return True on success.
+	 */
+	bool truncateFile(const int fd, const std::uint64_t length)
+	{
+#ifdef _WIN32
+		return ::_chsize_s(fd, static_cast<__int64>(length)) == 0;
+#else
+		return ::ftruncate(fd, static_cast<off_t>(length)) == 0;
+#endif
+	}
+
+	/**
+	 * Closes a descriptor.
+	 *
+	 * @param fd The descriptor.
+	 */
+	void closeFile(const int fd)
+	{
+#ifdef _WIN32
+		::_close(fd);
+#else
+		::close(fd);
+#endif
+	}
+
+	/**
+	 * Makes the creation and renaming of files in a directory durable. Windows has no equivalent.
+	 *
+	 * @param directory The directory.
+	 */
+	void syncDirectory([[maybe_unused]] const std::filesystem::path& directory)
+	{
+#ifndef _WIN32
+		const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd >= 0)
+		{
+			::fsync(fd);
+			::close(fd);
+		}
+#endif
+	}
+
+	/**
+	 * Writes a complete file under a temporary name, syncs it and moves it into place.
+	 *
+	 * @param fileToWrite The file to replace.
+	 * @param write Writes the contents to the descriptor it is given, false on failure.
+	 * @throws PlayerStoreException if the file cannot be written.
+	 */
+	template <typename Writer>
+	void replaceFile(const std::filesystem::path& fileToWrite, const Writer& write)
+	{
+		std::filesystem::path temporary = fileToWrite;
+		temporary += ".tmp";
+		const int fd = openFile(temporary, true);
+		const bool written = write(fd) && syncFile(fd);
+		closeFile(fd);
+
+		std::error_code error;
+		if (written)
+		{
+			std::filesystem::rename(temporary, fileToWrite, error);
+		}
+		if (!written || error)
+		{
+			std::filesystem::remove(temporary, error);
+			throw PlayerStoreException(fileToWrite.string(), "could not be written");
+		}
+		syncDirectory(fileToWrite.parent_path());
+	}
+
+	/**
+	 * @param generation The generation of the log.
+	 * @return The header of a log.
+	 */
+	std::string logHeader(const std::uint64_t generation)
+	{
+		PlayerStoreFormat::LogHeader header{};
+		std::memcpy(header.magic, PlayerStoreFormat::LOG_MAGIC, sizeof(header.magic));
+		header.version = PlayerStoreFormat::VERSION;
+		header.generation = generation;
+		return {reinterpret_cast<const char*>(&header), sizeof(header)};
+	}
+}
+
+/**
+ * Scores a won game and raises the level every WINS_PER_LEVEL wins.
+ *
+ * @param won True if the word was guessed.
+ * @param attemptsLeft The attempts left when the game ended.
+ * @param difficulty The difficulty of the word.
+ */
+void PlayerProfile::recordGame(const bool won, const int attemptsLeft, const WordDifficultyTypes difficulty)
+{
+	if (!won)
+	{
+		++losses;
+		return;
+	}
+	++wins;
+	score += static_cast<std::int64_t>(std::max(attemptsLeft, 0) + 1) * static_cast<int>(difficulty);
+	level = std::max(level, 1 + wins / WINS_PER_LEVEL);
+}
+
+/**
+ * Opens the store in a directory and starts the background sync.
+ *
+ * @param directory The directory holding the log and the snapshot.
+ * @param syncInterval How often buffered changes are written and synced, 0 to sync every change.
+ */
+PlayerStore::PlayerStore(std::filesystem::path directory, const std::chrono::milliseconds syncInterval) :
+	directory(std::move(directory)), syncInterval(syncInterval)
+{
+	open();
+	if (syncInterval.count() > 0)
+	{
+		syncer = std::thread(&PlayerStore::syncLoop, this);
+	}
+}
+
+/**
+ * Stops the background sync, writes what is buffered and a snapshot, and
+ * closes the log. Errors are ignored, the log holds every change that was written.
+ */
+PlayerStore::~PlayerStore()
+{
+	{
+		const std::lock_guard<std::mutex> lock(pendingMutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	if (syncer.joinable())
+	{
+		syncer.join();
+	}
+
+	const std::lock_guard<std::mutex> lock(ioMutex);
+	try
+	{
+		checkpointLocked();
+	}
+	catch (const PlayerStoreException&)
+	{
+		writePending();
+	}
+	closeFile(logFile);
+}
+
+/**
+ * Creates a new log, or loads the snapshot and replays the log after it.
+ */
+void PlayerStore::open()
+{
+	const std::filesystem::path logPath = directory / PlayerStoreFormat::LOG_FILE;
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error)
+	{
+		throw PlayerStoreException(directory.string(), "cannot be created");
+	}
+
+	const auto existingSize = std::filesystem::file_size(logPath, error);
+	if (error || existingSize == 0)
+	{
+		generation = RandomEngine::randomSeed();
+		const std::string header = logHeader(generation);
+		replaceFile(logPath, [&header](const int fd) { return writeAll(fd, header); });
+		logFile = openFile(logPath, false);
+		logLength = compactedLength = snapshotLength = header.size();
+		return;
+	}
+
+	std::uint64_t validLength = 0;
+	std::uint64_t fileLength = 0;
+	{
+		const MappedFile log(logPath);
+		const std::string_view contents = log.contents();
+		fileLength = contents.size();
+
+		PlayerStoreFormat::LogHeader header{};
+		if (contents.size() >= sizeof(header))
+		{
+			std::memcpy(&header, contents.data(), sizeof(header));
+		}
+		if (std::memcmp(header.magic, PlayerStoreFormat::LOG_MAGIC, sizeof(header.magic)) != 0 ||
+		    header.version != PlayerStoreFormat::VERSION)
+		{
+			throw PlayerStoreException(logPath.string(), "is not a player log of this version");
+		}
+		generation = header.generation;
+
+		validLength = snapshotLength = loadSnapshot(contents.size());
+		std::string_view name;
+		PlayerProfile profile;
+		while (decodeRecord(contents, validLength, name, profile))
+		{
+			shardOf(name).profiles[std::string(name)] = profile;
+		}
+	}
+
+	logFile = openFile(logPath, false);
+	if (validLength < fileLength && !(truncateFile(logFile, validLength) && syncFile(logFile)))
+	{
+		closeFile(logFile);
+		throw PlayerStoreException(logPath.string(), "damaged tail cannot be cut off");
+	}
+	logLength = compactedLength = validLength;
+}
+
+/**
+ * Loads the profiles of a snapshot that belongs to the current log. A snapshot
+ * that is damaged, of another generation or longer than the log is ignored.
+ *
+ * @param logSize The size of the log in bytes.
+ * @return The log offset replay starts from.
+ */
+std::uint64_t PlayerStore::loadSnapshot(const std::uint64_t logSize)
+{
+	const std::filesystem::path snapshotPath = directory / PlayerStoreFormat::SNAPSHOT_FILE;
+	std::error_code error;
+	if (!std::filesystem::is_regular_file(snapshotPath, error))
+	{
+		return sizeof(PlayerStoreFormat::LogHeader);
+	}
+
+	const MappedFile snapshot(snapshotPath);
+	const std::string_view contents = snapshot.contents();
+	PlayerStoreFormat::SnapshotHeader header{};
+	if (contents.size() < sizeof(header))
+	{
+		return sizeof(PlayerStoreFormat::LogHeader);
+	}
+	std::memcpy(&header, contents.data(), sizeof(header));
+	if (std::memcmp(header.magic, PlayerStoreFormat::SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+	    header.version != PlayerStoreFormat::VERSION || header.generation != generation ||
+	    header.logLength < sizeof(PlayerStoreFormat::LogHeader) || header.logLength > logSize ||
+	    header.playerCount > contents.size() / sizeof(PlayerStoreFormat::Record))
+	{
+		return sizeof(PlayerStoreFormat::LogHeader);
+	}
+
+	for (Shard& shard : shards)
+	{
+		shard.profiles.reserve(static_cast<std::size_t>(header.playerCount / SHARD_COUNT + header.playerCount / (4 * SHARD_COUNT)));
+	}
+
+	std::uint64_t offset = sizeof(header);
+	std::string_view name;
+	PlayerProfile profile;
+	for (std::uint64_t i = 0; i < header.playerCount; ++i)
+	{
+		if (!decodeRecord(contents, offset, name, profile))
+		{
+			for (Shard& shard : shards)
+			{
+				shard.profiles.clear();
+			}
+			return sizeof(PlayerStoreFormat::LogHeader);
+		}
+		shardOf(name).profiles.emplace(std::string(name), profile);
+	}
+	return header.logLength;
+}
+
+/**
+ * Picks the shard of a name.
+ *
+ * @param name The player's name.
+ * @return The shard holding the player.
+ */
+PlayerStore::Shard& PlayerStore::shardOf(const std::string_view name)
+{
+	return shards[std::hash<std::string_view>{}(name) % SHARD_COUNT];
+}
+
+/**
+ * Picks the shard of a name.
+ *
+ * @param name The player's name.
+ * @return The shard holding the player.
+ */
+const PlayerStore::Shard& PlayerStore::shardOf(const std::string_view name) const
+{
+	return shards[std::hash<std::string_view>{}(name) % SHARD_COUNT];
+}
+
+/**
+ * Looks up a player.
+ *
+ * @param name The player's name.
+ * @return The profile, or std::nullopt for an unknown player.
+ */
+std::optional<PlayerProfile> PlayerStore::find(const std::string_view name) const
+{
+	const Shard& shard = shardOf(name);
+	const std::lock_guard<std::mutex> lock(shard.mutex);
+	const auto found = shard.profiles.find(std::string(name));
+	if (found == shard.profiles.end())
+	{
+		return std::nullopt;
+	}
+	return found->second;
+}
+
+/**
+ * Changes a profile and buffers its record while the shard is locked, so the
+ * records of one player reach the log in the order of the changes.
+ *
+ * @param name The player's name.
+ * @param change Applied to the profile.
+ * @return The changed profile.
+ */
+PlayerProfile PlayerStore::update(const std::string_view name, const std::function<void(PlayerProfile&)>& change)
+{
+	if (name.empty() || name.size() > MAX_NAME_LENGTH)
+	{
+		throw std::invalid_argument("a player name must be 1 to 64 bytes long");
+	}
+
+	PlayerProfile result;
+	{
+		Shard& shard = shardOf(name);
+		const std::lock_guard<std::mutex> lock(shard.mutex);
+		PlayerProfile& profile = shard.profiles[std::string(name)];
+		change(profile);
+		result = profile;
+
+		const std::lock_guard<std::mutex> pendingLock(pendingMutex);
+		encodeRecord(pending, name, profile);
+	}
+
+	if (syncInterval.count() == 0)
+	{
+		flush();
+		maintain();
+	}
+	return result;
+}
+
+/**
+ * Adds the outcome of a game to a player's profile.
+ *
+ * @param name The player's name.
+ * @param won True if the word was guessed.
+ * @param attemptsLeft The attempts left when the game ended.
+ * @param difficulty The difficulty of the word.
+ * @return The changed profile.
+ */
+PlayerProfile PlayerStore::recordGame(const std::string_view name, const bool won, const int attemptsLeft,
+                                      const WordDifficultyTypes difficulty)
+{
+	return update(name, [&](PlayerProfile& profile) { profile.recordGame(won, attemptsLeft, difficulty); });
+}
+
+/**
+ * Counts the players over all shards.
+ *
+ * @return The number of players.
+ */
+std::size_t PlayerStore::size() const
+{
+	std::size_t count = 0;
+	for (const Shard& shard : shards)
+	{
+		const std::lock_guard<std::mutex> lock(shard.mutex);
+		count += shard.profiles.size();
+	}
+	return count;
+}
+
+/**
+ * Calls a function for every player, one shard at a time.
+ *
+ * @param visit Called with the name and profile of every player.
+ */
+void PlayerStore::forEach(const std::function<void(std::string_view, const PlayerProfile&)>& visit) const
+{
+	for (const Shard& shard : shards)
+	{
+		const std::lock_guard<std::mutex> lock(shard.mutex);
+		for (const auto& [name, profile] : shard.profiles)
+		{
+			visit(name, profile);
+		}
+	}
+}
+
+/**
+ * Writes and syncs the buffered changes.
+ */
+void PlayerStore::flush()
+{
+	const std::lock_guard<std::mutex> lock(ioMutex);
+	if (!writePending())
+	{
+		throw PlayerStoreException((directory / PlayerStoreFormat::LOG_FILE).string(), "could not be written");
+	}
+}
+
+/**
+ * Writes a snapshot of the index.
+ */
+void PlayerStore::checkpoint()
+{
+	const std::lock_guard<std::mutex> lock(ioMutex);
+	checkpointLocked();
+}
+
+/**
+ * Takes the buffered records, appends them to the log in one write and syncs
+ * it. A failed write is cut off again so later records do not land behind a
+ * damaged one.
+ *
+ * @return False if the log could not be written.
+ */
+bool PlayerStore::writePending()
+{
+	std::string batch;
+	{
+		const std::lock_guard<std::mutex> lock(pendingMutex);
+		batch.swap(pending);
+	}
+	if (batch.empty())
+	{
+		return true;
+	}
+
+	if (!writeAll(logFile, batch) || !syncFile(logFile))
+	{
+		truncateFile(logFile, logLength);
+		const std::lock_guard<std::mutex> lock(pendingMutex);
+		pending.insert(0, batch);
+		return false;
+	}
+	logLength += batch.size();
+	return true;
+}
+
+/**
+ * Writes the snapshot one shard at a time, so changes only wait for the shard
+ * being copied. A profile copied after `logLength` reflects changes whose
+ * records lie beyond it, which is harmless: replaying those records sets the
+ * same or newer values.
+ */
+void PlayerStore::checkpointLocked()
+{
+	if (!writePending())
+	{
+		throw PlayerStoreException((directory / PlayerStoreFormat::LOG_FILE).string(), "could not be written");
+	}
+
+	const std::uint64_t includedLength = logLength;
+	replaceFile(directory / PlayerStoreFormat::SNAPSHOT_FILE, [&](const int fd) {
+		PlayerStoreFormat::SnapshotHeader header{};
+		std::memcpy(header.magic, PlayerStoreFormat::SNAPSHOT_MAGIC, sizeof(header.magic));
+		header.version = PlayerStoreFormat::VERSION;
+		header.generation = generation;
+		header.logLength = includedLength;
+		if (!writeAll(fd, {reinterpret_cast<const char*>(&header), sizeof(header)}))
+		{
+			return false;
+		}
+
+		std::string records;
+		for (const Shard& shard : shards)
+		{
+			{
+				const std::lock_guard<std::mutex> lock(shard.mutex);
+				for (const auto& [name, profile] : shard.profiles)
+				{
+					encodeRecord(records, name, profile);
+				}
+				header.playerCount += shard.profiles.size();
+			}
+			if (!writeAll(fd, records))
+			{
+				return false;
+			}
+			records.clear();
+		}
+		return writeAt(fd, 0, {reinterpret_cast<const char*>(&header), sizeof(header)});
+	});
+	snapshotLength = includedLength;
+}
+
+/**
+ * Copies every profile while all shards are locked, which makes the copy a
+ * consistent cut of the log, then writes the copy as the new log without
+ * holding the shards. Records buffered before the cut are dropped once the
+ * new log is in place; records buffered after it follow the copy.
+ */
+void PlayerStore::compact()
+{
+	const std::lock_guard<std::mutex> lock(ioMutex);
+	if (!writePending())
+	{
+		throw PlayerStoreException((directory / PlayerStoreFormat::LOG_FILE).string(), "could not be written");
+	}
+
+	const std::uint64_t newGeneration = generation + 1;
+	std::string contents = logHeader(newGeneration);
+	std::size_t pendingAtCut = 0;
+	{
+		std::vector<std::unique_lock<std::mutex>> locks;
+		locks.reserve(SHARD_COUNT);
+		for (Shard& shard : shards)
+		{
+			locks.emplace_back(shard.mutex);
+		}
+		for (const Shard& shard : shards)
+		{
+			for (const auto& [name, profile] : shard.profiles)
+			{
+				encodeRecord(contents, name, profile);
+			}
+		}
+		const std::lock_guard<std::mutex> pendingLock(pendingMutex);
+		pendingAtCut = pending.size();
+	}
+
+	const std::filesystem::path logPath = directory / PlayerStoreFormat::LOG_FILE;
+	replaceFile(logPath, [&contents](const int fd) { return writeAll(fd, contents); });
+	{
+		const std::lock_guard<std::mutex> pendingLock(pendingMutex);
+		pending.erase(0, pendingAtCut);
+	}
+
+	const int compactedFile = openFile(logPath, false);
+	closeFile(logFile);
+	logFile = compactedFile;
+	generation = newGeneration;
+	logLength = compactedLength = contents.size();
+	snapshotLength = 0;
+	contents = {};
+	checkpointLocked();
+}
+
+/**
+ * Writes the buffered records, then takes a snapshot after CHECKPOINT_BYTES of
+ * log growth or compacts once the log has doubled plus COMPACTION_SLACK. A
+ * failure is retried on the next call.
+ */
+void PlayerStore::maintain()
+{
+	std::unique_lock<std::mutex> lock(ioMutex);
+	if (!writePending())
+	{
+		return;
+	}
+	try
+	{
+		if (logLength >= 2 * compactedLength + COMPACTION_SLACK)
+		{
+			lock.unlock();
+			compact();
+		}
+		else if (logLength >= snapshotLength + CHECKPOINT_BYTES)
+		{
+			checkpointLocked();
+		}
+	}
+	catch (const PlayerStoreException&)
+	{
+		// Everything written is still in the log, the next call tries again
+	}
+}
+
+/**
+ * Calls maintain() every sync interval until the destructor sets `stopping`.
+ */
+void PlayerStore::syncLoop()
+{
+	std::unique_lock<std::mutex> lock(pendingMutex);
+	while (!stopping)
+	{
+		wake.wait_for(lock, syncInterval, [this] { return stopping; });
+		lock.unlock();
+		maintain();
+		lock.lock();
+	}
+}
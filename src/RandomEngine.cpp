@@ -0,0 +1,40 @@
+#include <RandomEngine.h>
+
+#include <random>
+
+/**
+ * Constructs an engine seeded once from std::random_device.
+ */
+RandomEngine::RandomEngine()
+{
+	setSeed(randomSeed());
+}
+
+/**
+ * Expands a 64 bit seed into the full generator state with splitmix64, which
+ * never produces the all-zero state xoshiro cannot leave.
+ *
+ * @param seed The seed. Equal seeds produce equal sequences.
+ */
+void RandomEngine::setSeed(std::uint64_t seed)
+{
+	for (auto& word : state)
+	{
+		seed += 0x9e3779b97f4a7c15u;
+		std::uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+		word = z ^ (z >> 31);
+	}
+}
+
+/**
+ * Draws a fresh seed from std::random_device.
+ *
+ * @return A non-deterministic seed.
+ */
+std::uint64_t RandomEngine::randomSeed()
+{
+	std::random_device rd;
+	return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
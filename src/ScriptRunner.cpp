@@ -0,0 +1,301 @@
+#include <ScriptRunner.h>
+
+#include <cctype>
+#include <charconv>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Names of the GameStatus values, in declaration order.
+	 */
+	constexpr std::string_view GAME_STATUS_NAMES[] = {"NOT_STARTED", "IN_PROGRESS", "WON", "LOST"};
+
+	/**
+	 * @param c A character of a command.
+	 * @return True for a space or a tab.
+	 */
+	bool isBlank(const char c)
+	{
+		return c == ' ' || c == '\t';
+	}
+
+	/**
+	 * Splits the first blank-separated token off a string.
+	 *
+	 * @param text The text, advanced past the token.
+	 * @return The token, empty if the text is blank.
+	 */
+	std::string_view nextToken(std::string_view& text)
+	{
+		std::size_t start = 0;
+		while (start < text.size() && isBlank(text[start]))
+		{
+			++start;
+		}
+		std::size_t end = start;
+		while (end < text.size() && !isBlank(text[end]))
+		{
+			++end;
+		}
+		const std::string_view token = text.substr(start, end - start);
+		text.remove_prefix(end);
+		return token;
+	}
+
+	/**
+	 * Compares a token with a lowercase keyword, ignoring case.
+	 *
+	 * @param token The token from the command.
+	 * @param keyword The lowercase keyword.
+	 * @return True if they are equal apart from case.
+	 */
+	bool isKeyword(const std::string_view token, const std::string_view keyword)
+	{
+		if (token.size() != keyword.size())
+		{
+			return false;
+		}
+		for (std::size_t i = 0; i < token.size(); ++i)
+		{
+			if (std::tolower(static_cast<unsigned char>(token[i])) != keyword[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Appends an unsigned number in decimal.
+	 *
+	 * @param out Receives the digits.
+	 * @param value The number.
+	 */
+	void appendNumber(std::string& out, const std::uint64_t value)
+	{
+		char digits[20];
+		const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+		out.append(digits, result.ptr);
+	}
+}
+
+/**
+ * Constructs a runner picking words from a dictionary.
+ *
+ * @param dictionary The dictionary NEW picks words from.
+ */
+ScriptRunner::ScriptRunner(std::shared_ptr<const WordIndex> dictionary) : engine(std::move(dictionary))
+{
+}
+
+/**
+ * Records every game in a journal.
+ *
+ * @param journal The journal, or nullptr to stop recording.
+ */
+void ScriptRunner::setJournal(std::shared_ptr<Journal> journal)
+{
+	engine.setJournal(std::move(journal));
+}
+
+/**
+ * Executes every command of the input. The input is read in blocks and cut
+ * into lines in place, a line spanning two blocks is carried over, and the
+ * results are collected until a block is full.
+ *
+ * @param input The commands.
+ * @param output Receives the results.
+ * @return What the run did.
+ */
+ScriptStats ScriptRunner::run(std::istream& input, std::ostream& output)
+{
+	stats = ScriptStats{};
+	std::vector<char> block(BLOCK_SIZE);
+	std::string carry;
+	std::string results;
+	results.reserve(BLOCK_SIZE + 256);
+	std::uint64_t number = 0;
+
+	const auto writeResults = [&output, &results](const std::size_t threshold) {
+		if (results.size() >= threshold)
+		{
+			output.write(results.data(), static_cast<std::streamsize>(results.size()));
+			results.clear();
+		}
+	};
+
+	while (input)
+	{
+		input.read(block.data(), static_cast<std::streamsize>(block.size()));
+		const auto count = static_cast<std::size_t>(input.gcount());
+		std::string_view data(block.data(), count);
+
+		while (!data.empty())
+		{
+			const std::size_t end = data.find('\n');
+			if (end == std::string_view::npos)
+			{
+				carry.append(data);
+				break;
+			}
+			if (carry.empty())
+			{
+				execute(data.substr(0, end), ++number, results);
+			}
+			else
+			{
+				carry.append(data.substr(0, end));
+				execute(carry, ++number, results);
+				carry.clear();
+			}
+			data.remove_prefix(end + 1);
+			writeResults(BLOCK_SIZE);
+		}
+	}
+	if (!carry.empty())
+	{
+		execute(carry, ++number, results);
+	}
+
+	report(results);
+	writeResults(1);
+	return stats;
+}
+
+/**
+ * Executes one command.
+ *
+ * @param line The command, without the line terminator.
+ * @param number The line number, for error messages.
+ * @param results Receives the result lines.
+ */
+void ScriptRunner::execute(std::string_view line, const std::uint64_t number, std::string& results)
+{
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+	const std::string_view command = nextToken(line);
+	if (command.empty() || command.front() == '#')
+	{
+		return;
+	}
+	const std::string_view argument = nextToken(line);
+
+	const auto fail = [this, number, &results](const std::string_view reason) {
+		++stats.errors;
+		results += "ERR ";
+		appendNumber(results, number);
+		results += ' ';
+		results += reason;
+		results += '\n';
+	};
+
+	if (isKeyword(command, "guess"))
+	{
+		if (engine.status() == GameStatus::NOT_STARTED)
+		{
+			fail("no game, use NEW or WORD first");
+			return;
+		}
+		for (const char letter : argument)
+		{
+			if (engine.guess(letter) == GuessResult::GAME_OVER)
+			{
+				break;
+			}
+			++gameGuesses;
+		}
+		if (engine.over())
+		{
+			report(results);
+		}
+	}
+	else if (isKeyword(command, "new"))
+	{
+		std::uint64_t seed = 0;
+		const auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), seed);
+		if (argument.empty() || error != std::errc() || end != argument.data() + argument.size())
+		{
+			fail("NEW takes a seed");
+			return;
+		}
+		const std::string_view level = nextToken(line);
+		WordDifficultyTypes difficulty = WordDifficultyTypes::MEDIUM;
+		if (isKeyword(level, "easy"))
+		{
+			difficulty = WordDifficultyTypes::EASY;
+		}
+		else if (isKeyword(level, "hard"))
+		{
+			difficulty = WordDifficultyTypes::HARD;
+		}
+		else if (!level.empty() && !isKeyword(level, "medium"))
+		{
+			fail("unknown difficulty");
+			return;
+		}
+
+		// Only a NEW that can start a game ends the current one, which must be reported before it is replaced
+		const auto& dictionary = engine.getDictionary();
+		const WordListView words = dictionary ? dictionary->forDifficulty(difficulty) : WordListView();
+		if (words.empty())
+		{
+			fail("no word of that difficulty");
+			return;
+		}
+		report(results);
+		engine.setSeed(seed);
+		engine.newGame(words, difficulty);
+		gameGuesses = 0;
+		unreported = true;
+	}
+	else if (isKeyword(command, "word"))
+	{
+		if (argument.empty())
+		{
+			fail("WORD takes a word");
+			return;
+		}
+		report(results);
+		engine.newGameWithWord(argument);
+		gameGuesses = 0;
+		unreported = true;
+		if (engine.over())
+		{
+			report(results);
+		}
+	}
+	else
+	{
+		fail("unknown command");
+	}
+}
+
+/**
+ * Appends `<STATUS> <word> <attempts left> <guesses>` for the current game
+ * unless it was reported already.
+ *
+ * @param results Receives the result line.
+ */
+void ScriptRunner::report(std::string& results)
+{
+	if (!unreported)
+	{
+		return;
+	}
+	unreported = false;
+	++stats.games;
+	stats.guesses += gameGuesses;
+
+	results += GAME_STATUS_NAMES[static_cast<std::size_t>(engine.status())];
+	results += ' ';
+	results += engine.targetWord();
+	results += ' ';
+	appendNumber(results, static_cast<std::uint64_t>(engine.attemptsLeft()));
+	results += ' ';
+	appendNumber(results, gameGuesses);
+	results += '\n';
+}
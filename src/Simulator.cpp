@@ -0,0 +1,181 @@
+#include <Simulator.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Adds the totals of another set of games.
+ *
+ * @param other The totals to add.
+ */
+void DifficultyStats::merge(const DifficultyStats& other)
+{
+	games += other.games;
+	wins += other.wins;
+	guesses += other.guesses;
+	incorrectGuesses += other.incorrectGuesses;
+}
+
+/**
+ * @return The fraction of games won, 0 if no game was played.
+ */
+double DifficultyStats::winRate() const
+{
+	return games == 0 ? 0.0 : static_cast<double>(wins) / static_cast<double>(games);
+}
+
+/**
+ * @return The average number of guesses per game, 0 if no game was played.
+ */
+double DifficultyStats::averageGuesses() const
+{
+	return games == 0 ? 0.0 : static_cast<double>(guesses) / static_cast<double>(games);
+}
+
+/**
+ * Adds the totals of another set of games, the duration is not changed.
+ *
+ * @param other The totals to add.
+ */
+void SimulationStats::merge(const SimulationStats& other)
+{
+	for (std::size_t i = 0; i < byDifficulty.size(); ++i)
+	{
+		byDifficulty[i].merge(other.byDifficulty[i]);
+	}
+}
+
+/**
+ * @return The totals over every difficulty.
+ */
+DifficultyStats SimulationStats::total() const
+{
+	DifficultyStats sum;
+	for (const auto& stats : byDifficulty)
+	{
+		sum.merge(stats);
+	}
+	return sum;
+}
+
+/**
+ * @return Games played per second of wall clock time.
+ */
+double SimulationStats::gamesPerSecond() const
+{
+	return seconds <= 0.0 ? 0.0 : static_cast<double>(total().games) / seconds;
+}
+
+/**
+ * Maps a difficulty to its slot in byDifficulty.
+ *
+ * @param difficulty The difficulty.
+ * @return The index of the difficulty.
+ */
+std::size_t SimulationStats::difficultyIndex(const WordDifficultyTypes difficulty)
+{
+	return static_cast<std::size_t>(difficulty) - static_cast<std::size_t>(WordDifficultyTypes::EASY);
+}
+
+/**
+ * Plays the configured games in chunks on a work-stealing pool.
+ *
+ * @param config What to simulate.
+ * @return The merged statistics.
+ */
+SimulationStats Simulator::run(const SimulationConfig& config)
+{
+	SimulationStats result;
+	if (!config.dictionary || !config.strategy || config.difficulties.empty() || config.games == 0)
+	{
+		return result;
+	}
+
+	// State private to each worker, padded so workers never share a cache line
+	struct alignas(64) WorkerState
+	{
+		GameEngine game;
+		std::unique_ptr<GuessStrategy> strategy;
+		SimulationStats stats;
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	{
+		ThreadPool pool(config.threads == 0 ? std::thread::hardware_concurrency() : config.threads);
+		std::vector<WorkerState> workers(pool.size());
+		for (auto& worker : workers)
+		{
+			worker.game.setDictionary(config.dictionary);
+			worker.game.setJournal(config.journal);
+			worker.strategy = config.strategy();
+		}
+
+		// Resolve the word list of every difficulty once, not per game
+		std::array<WordListView, 3> wordLists;
+		for (const auto difficulty : config.difficulties)
+		{
+			wordLists[SimulationStats::difficultyIndex(difficulty)] = config.dictionary->forDifficulty(difficulty);
+		}
+
+		for (std::uint64_t first = 0; first < config.games; first += GAMES_PER_TASK)
+		{
+			const std::uint64_t last = std::min(config.games, first + GAMES_PER_TASK);
+			pool.submit([&config, &workers, &wordLists, first, last] {
+				WorkerState& worker = workers[ThreadPool::currentWorker()];
+				for (std::uint64_t i = first; i < last; ++i)
+				{
+					const WordDifficultyTypes difficulty = config.difficulties[i % config.difficulties.size()];
+					const std::size_t slot = SimulationStats::difficultyIndex(difficulty);
+
+					worker.game.setSeed(config.seed + i);
+					if (!worker.game.newGame(wordLists[slot], difficulty))
+					{
+						continue;
+					}
+					worker.strategy->newGame(worker.game, config.seed + i);
+					playGame(worker.game, *worker.strategy, worker.stats.byDifficulty[slot]);
+				}
+			});
+		}
+		pool.wait();
+
+		for (const auto& worker : workers)
+		{
+			result.merge(worker.stats);
+		}
+	}
+	if (config.journal)
+	{
+		config.journal->flush();
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+/**
+ * Lets the strategy guess until the game is won or lost.
+ *
+ * @param game The engine to play on, the game must already be started.
+ * @param strategy The guesser.
+ * @param stats Receives the outcome of the game.
+ */
+void Simulator::playGame(GameEngine& game, GuessStrategy& strategy, DifficultyStats& stats)
+{
+	while (!game.over())
+	{
+		const GuessResult result = game.guess(strategy.nextGuess(game));
+		if (result == GuessResult::CORRECT || result == GuessResult::INCORRECT)
+		{
+			++stats.guesses;
+			stats.incorrectGuesses += result == GuessResult::INCORRECT ? 1 : 0;
+		}
+		else
+		{
+			break; // the strategy repeated itself or made up a letter, give up on the game
+		}
+	}
+
+	++stats.games;
+	stats.wins += game.won() ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+#include <Solver.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	/**
+	 * Compares two characters of a word, letters ignoring case like the letter masks.
+	 *
+	 * @param a A character.
+	 * @param b Another character.
+	 * @return True if both are the same letter in either case, or the same other character.
+	 */
+	bool sameCharacter(const char a, const char b)
+	{
+		const LetterMask bit = letterBit(a);
+		return bit != 0 ? bit == letterBit(b) : a == b;
+	}
+}
+
+/**
+ * Constructs a solver over a list of same-length words.
+ *
+ * @param words The words of the target's length.
+ */
+Solver::Solver(const WordListView& words)
+{
+	reset(words);
+}
+
+/**
+ * Restarts with every word of the list as a candidate.
+ *
+ * @param words The words of the target's length.
+ */
+void Solver::reset(const WordListView& words)
+{
+	this->words = words;
+	guessedLetters = 0;
+	candidates.resize(words.size());
+	candidateMasks.resize(words.size());
+	for (std::size_t i = 0; i < words.size(); ++i)
+	{
+		candidates[i] = static_cast<std::uint32_t>(i);
+		candidateMasks[i] = words.letterMask(i);
+	}
+}
+
+/**
+ * Narrows the candidates in place. The letter masks reject most words with two
+ * mask compares before any character is looked at. The first narrowing of a
+ * large list, which would scan every word, asks the pattern index instead.
+ *
+ * @param pattern The masked word, with '_' for every hidden letter.
+ * @param wrongLetters The letters known not to be in the word.
+ */
+void Solver::update(const std::string_view pattern, const LetterMask wrongLetters)
+{
+	const LetterMask revealed = letterMaskOf(pattern);
+	guessedLetters = revealed | wrongLetters;
+
+	if (candidates.size() == words.size() && words.size() >= PATTERN_INDEX_MIN_WORDS &&
+	    matchIndexed(pattern, wrongLetters))
+	{
+		return;
+	}
+
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < candidates.size(); ++i)
+	{
+		const LetterMask mask = candidateMasks[i];
+		if ((mask & wrongLetters) != 0 || (mask & revealed) != revealed)
+		{
+			continue;
+		}
+
+		const std::string_view word = words[candidates[i]];
+		if (word.size() != pattern.size())
+		{
+			continue;
+		}
+
+		bool matches = true;
+		for (std::size_t position = 0; matches && position < word.size(); ++position)
+		{
+			// A hidden position cannot hold a revealed letter, or it would have been shown
+			matches = pattern[position] == '_' ? (letterBit(word[position]) & revealed) == 0
+			                                   : sameCharacter(word[position], pattern[position]);
+		}
+		if (matches)
+		{
+			candidates[kept] = candidates[i];
+			candidateMasks[kept] = mask;
+			++kept;
+		}
+	}
+	candidates.resize(kept);
+	candidateMasks.resize(kept);
+}
+
+/**
+ * Replaces the candidates by the matches of the pattern index. Only patterns
+ * that reveal nothing but letters can be looked up, the index does not hold
+ * other characters.
+ *
+ * @param pattern The masked word, with '_' for every hidden letter.
+ * @param wrongLetters The letters known not to be in the word.
+ * @return True if the candidates were replaced.
+ */
+bool Solver::matchIndexed(const std::string_view pattern, const LetterMask wrongLetters)
+{
+	if (!words.index() || pattern.size() != words[0].size())
+	{
+		return false;
+	}
+	for (const char c : pattern)
+	{
+		if (c != '_' && letterBit(c) == 0)
+		{
+			return false;
+		}
+	}
+	if (!patterns || patterns->begin() != words.begin())
+	{
+		patterns = words.index()->patternIndex(pattern.size());
+	}
+	if (patterns->begin() != words.begin() || patterns->size() != words.size())
+	{
+		return false;
+	}
+
+	patterns->match(pattern, wrongLetters, matchBits);
+	candidates.clear();
+	candidateMasks.clear();
+	PatternIndex::forEach(matchBits, [this](const std::size_t i) {
+		candidates.push_back(static_cast<std::uint32_t>(i));
+		candidateMasks.push_back(words.letterMask(i));
+	});
+	return true;
+}
+
+/**
+ * Counts, for every letter, the candidates that contain it. Each letter is one
+ * branch-free pass over the contiguous masks, which the compiler vectorizes.
+ *
+ * @return The counts, with 'a' at index 0.
+ */
+std::array<std::uint32_t, 26> Solver::letterCounts() const
+{
+	std::array<std::uint32_t, 26> counts{};
+	const LetterMask* const masks = candidateMasks.data();
+	const std::size_t count = candidateMasks.size();
+
+	for (unsigned letter = 0; letter < counts.size(); ++letter)
+	{
+		std::uint32_t total = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			total += (masks[i] >> letter) & 1u;
+		}
+		counts[letter] = total;
+	}
+	return counts;
+}
+
+/**
+ * Picks the unguessed letter whose answer carries the most information. Letters
+ * found in every candidate or in none cannot split the set; the first kind is
+ * still worth guessing once nothing else is.
+ *
+ * @return The suggested letter, or '\0' when no letter can be suggested.
+ */
+char Solver::bestGuess() const
+{
+	if (candidates.empty())
+	{
+		return '\0';
+	}
+
+	const auto counts = letterCounts();
+	char best = '\0';
+	double bestEntropy = -1.0;
+	std::uint32_t bestCount = 0;
+
+	for (char letter = 'a'; letter <= 'z'; ++letter)
+	{
+		const std::uint32_t count = counts[static_cast<std::size_t>(letter - 'a')];
+		if (count == 0 || (guessedLetters & letterBit(letter)) != 0)
+		{
+			continue;
+		}
+
+		const double entropy = revealEntropy(letter);
+		if (entropy > bestEntropy || (entropy == bestEntropy && count > bestCount))
+		{
+			best = letter;
+			bestEntropy = entropy;
+			bestCount = count;
+		}
+	}
+	return best;
+}
+
+/**
+ * Computes the entropy of the answer to guessing a letter: candidates are
+ * grouped by the set of positions the letter occupies, a miss being the empty set.
+ *
+ * @param letter The letter, from 'a' to 'z'.
+ * @return The entropy in bits over the remaining candidates.
+ */
+double Solver::revealEntropy(const char letter) const
+{
+	const LetterMask bit = letterBit(letter);
+	std::vector<std::uint64_t> outcomes;
+	outcomes.reserve(candidates.size());
+	for (const auto candidate : candidates)
+	{
+		const std::string_view word = words[candidate];
+		std::uint64_t positions = 0;
+		for (std::size_t position = 0; position < word.size(); ++position)
+		{
+			// Positions past 63 share a bit, which only merges some very long outcomes
+			positions |= static_cast<std::uint64_t>(letterBit(word[position]) == bit) << std::min<std::size_t>(position, 63);
+		}
+		outcomes.push_back(positions);
+	}
+	std::sort(outcomes.begin(), outcomes.end());
+
+	const auto total = static_cast<double>(outcomes.size());
+	double entropy = 0.0;
+	for (std::size_t first = 0; first < outcomes.size();)
+	{
+		std::size_t last = first + 1;
+		while (last < outcomes.size() && outcomes[last] == outcomes[first])
+		{
+			++last;
+		}
+		const double p = static_cast<double>(last - first) / total;
+		entropy -= p * std::log2(p);
+		first = last;
+	}
+	return entropy;
+}
@@ -0,0 +1,217 @@
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief The pool and worker index of the calling thread, if it is a worker.
+	 */
+	thread_local const ThreadPool* currentPool = nullptr;
+	thread_local std::size_t currentIndex = ThreadPool::NOT_A_WORKER;
+}
+
+/**
+ * Starts the worker threads.
+ *
+ * @param threadCount The number of workers, at least 1.
+ */
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+	threadCount = std::max<std::size_t>(threadCount, 1);
+	queues.reserve(threadCount);
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		queues.push_back(std::make_unique<TaskQueue>());
+	}
+
+	workers.reserve(threadCount);
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		workers.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+/**
+ * Waits for all submitted tasks, then stops and joins the workers. An
+ * exception of a task nobody waited for is dropped, a destructor cannot throw.
+ */
+ThreadPool::~ThreadPool()
+{
+	try
+	{
+		wait();
+	}
+	catch (...)
+	{
+	}
+	{
+		const std::lock_guard<std::mutex> lock(stateMutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/**
+ * Queues a task, on the calling worker's own queue when called from inside the
+ * pool, otherwise on the next queue in round-robin order. The pool-wide mutex
+ * is only taken when a worker is parked, so that the wake-up cannot fall
+ * between its last look at the queues and its wait.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+	const std::size_t target =
+		currentPool == this ? currentIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+	// Count the task before it becomes visible, so that wait() cannot return before it ran
+	unfinishedTasks.fetch_add(1);
+	{
+		TaskQueue& queue = *queues[target];
+		const std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+		queuedTasks.fetch_add(1);
+	}
+
+	if (parkedWorkers.load() > 0)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(stateMutex);
+		}
+		workAvailable.notify_one();
+	}
+}
+
+/**
+ * Blocks until every submitted task has finished, then rethrows the first
+ * exception one of them threw.
+ */
+void ThreadPool::wait()
+{
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(stateMutex);
+		allDone.wait(lock, [this] { return unfinishedTasks.load() == 0; });
+		error = std::exchange(firstError, nullptr);
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+/**
+ * Identifies the worker running the calling thread.
+ *
+ * @return The index of the calling worker, or NOT_A_WORKER outside any pool.
+ */
+std::size_t ThreadPool::currentWorker()
+{
+	return currentIndex;
+}
+
+/**
+ * Runs tasks until the pool stops. A worker that finds every queue empty
+ * parks until a task is queued; the count of queued tasks only covers tasks
+ * that are really in a queue, so a woken worker either finds one or parks again.
+ *
+ * @param index The index of the worker.
+ */
+void ThreadPool::workerLoop(const std::size_t index)
+{
+	currentPool = this;
+	currentIndex = index;
+
+	std::function<void()> task;
+	for (;;)
+	{
+		if (takeTask(index, task))
+		{
+			run(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(stateMutex);
+		// Announce the worker before looking at the count, submit() looks at them the other way round
+		parkedWorkers.fetch_add(1);
+		workAvailable.wait(lock, [this] { return queuedTasks.load() > 0 || stopping; });
+		parkedWorkers.fetch_sub(1);
+		if (stopping && queuedTasks.load() == 0)
+		{
+			return;
+		}
+	}
+}
+
+/**
+ * Runs a task, keeps the first exception thrown since the last wait() and
+ * counts the task finished either way.
+ *
+ * @param task The task, emptied afterwards.
+ */
+void ThreadPool::run(std::function<void()>& task)
+{
+	try
+	{
+		task();
+	}
+	catch (...)
+	{
+		const std::lock_guard<std::mutex> lock(stateMutex);
+		if (!firstError)
+		{
+			firstError = std::current_exception();
+		}
+	}
+	task = nullptr;
+
+	if (unfinishedTasks.fetch_sub(1) == 1)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(stateMutex);
+		}
+		allDone.notify_all();
+	}
+}
+
+/**
+ * Takes the newest task of the worker's own queue, or failing that steals the
+ * oldest task of another worker's queue.
+ *
+ * @param index The index of the worker looking for work.
+ * @param task Receives the task.
+ * @return True if a task was found.
+ */
+bool ThreadPool::takeTask(const std::size_t index, std::function<void()>& task)
+{
+	{
+		TaskQueue& own = *queues[index];
+		const std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			queuedTasks.fetch_sub(1);
+			return true;
+		}
+	}
+
+	for (std::size_t offset = 1; offset < queues.size(); ++offset)
+	{
+		TaskQueue& victim = *queues[(index + offset) % queues.size()];
+		const std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			queuedTasks.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,144 @@
+#include <Trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief One finished span.
+	 */
+	struct TraceEvent
+	{
+		const char* name;
+		std::chrono::steady_clock::time_point start;
+		std::chrono::steady_clock::duration duration;
+	};
+
+	/**
+	 * @brief The ring buffer of one thread.
+	 */
+	struct ThreadTrace
+	{
+		explicit ThreadTrace(const std::size_t threadId) : threadId(threadId), events(Tracer::TRACE_BUFFER_EVENTS)
+		{
+		}
+
+		std::size_t threadId;
+		std::vector<TraceEvent> events;
+		std::atomic<std::uint64_t> written{0};
+	};
+
+	/**
+	 * @brief The buffers of every thread that recorded a span, kept after the thread exits.
+	 */
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadTrace>> threads;
+	};
+
+	/**
+	 * @brief The time trace timestamps count from, taken when the program starts.
+	 */
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	/**
+	 * @return The registry. Never destroyed, so spans closing during exit still have somewhere to go.
+	 */
+	Registry& registry()
+	{
+		static Registry* const instance = new Registry();
+		return *instance;
+	}
+
+	/**
+	 * @return The ring buffer of the calling thread, created on its first span.
+	 */
+	ThreadTrace& localTrace()
+	{
+		thread_local ThreadTrace* trace = nullptr;
+		if (trace == nullptr)
+		{
+			Registry& shared = registry();
+			const std::lock_guard<std::mutex> lock(shared.mutex);
+			shared.threads.push_back(std::make_unique<ThreadTrace>(shared.threads.size() + 1));
+			trace = shared.threads.back().get();
+		}
+		return *trace;
+	}
+}
+
+/**
+ * Stores the span in the calling thread's ring buffer, overwriting the oldest
+ * once it is full, and publishes it with a release store of the write count.
+ *
+ * @param name The span name.
+ * @param start When the span began.
+ * @param end When the span ended.
+ */
+void Tracer::record(const char* name, const std::chrono::steady_clock::time_point start,
+                    const std::chrono::steady_clock::time_point end)
+{
+	ThreadTrace& trace = localTrace();
+	const std::uint64_t position = trace.written.load(std::memory_order_relaxed);
+	trace.events[position % TRACE_BUFFER_EVENTS] = {name, start, end - start};
+	trace.written.store(position + 1, std::memory_order_release);
+}
+
+/**
+ * Writes one complete event per span, oldest first within each thread, with
+ * timestamps in microseconds since the program started.
+ *
+ * @param out The stream to write to.
+ */
+void Tracer::writeChromeTrace(std::ostream& out)
+{
+	Registry& shared = registry();
+	const std::lock_guard<std::mutex> lock(shared.mutex);
+
+	const auto microseconds = [](const std::chrono::steady_clock::duration duration) {
+		return std::chrono::duration<double, std::micro>(duration).count();
+	};
+
+	out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+	bool first = true;
+	for (const auto& trace : shared.threads)
+	{
+		const std::uint64_t written = trace->written.load(std::memory_order_acquire);
+		const std::uint64_t kept = std::min<std::uint64_t>(written, TRACE_BUFFER_EVENTS);
+		for (std::uint64_t position = written - kept; position < written; ++position)
+		{
+			const TraceEvent& event = trace->events[position % TRACE_BUFFER_EVENTS];
+			out << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+			    << "\",\"cat\":\"hangman\",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace->threadId
+			    << ",\"ts\":" << microseconds(event.start - epoch) << ",\"dur\":" << microseconds(event.duration)
+			    << '}';
+			first = false;
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+/**
+ * Writes the trace to a file.
+ *
+ * @param fileToWrite Path of the trace file to create or replace.
+ * @return True if the file was written successfully.
+ */
+bool Tracer::writeChromeTrace(const std::filesystem::path& fileToWrite)
+{
+	std::ofstream out(fileToWrite, std::ios::trunc);
+	if (!out.is_open())
+	{
+		return false;
+	}
+	writeChromeTrace(out);
+	out.close();
+	return static_cast<bool>(out);
+}
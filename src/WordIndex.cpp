@@ -0,0 +1,853 @@
+#include <WordIndex.h>
+#include <DictionaryFormat.h>
+#include <ThreadPool.h>
+#include <invalid_dictionary_exception.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+/**
+ * Memory-maps the dictionary file and indexes it by word length.
+ *
+ * Every word is a view into the mapping, so loading performs no per-word heap
+ * allocation. Compiled dictionaries are only validated, text word lists are
+ * split into lines, where lines may end in LF or CRLF, trailing whitespace is
+ * trimmed, lines that end up empty are skipped and a trailing weight column
+ * is separated from the word.
+ *
+ * @param fileToRead Path to the dictionary file.
+ * @param threads The number of threads parsing a text word list, 0 for one per hardware thread.
+ * @return The shared, immutable index.
+ * @throws FileNotFoundException if the specified file cannot be opened.
+ * @throws InvalidDictionaryException if a compiled dictionary fails validation.
+ */
+std::shared_ptr<const WordIndex> WordIndex::load(const std::filesystem::path& fileToRead, std::size_t threads)
+{
+	std::shared_ptr<WordIndex> index(new WordIndex());
+	index->storage = MappedFile(fileToRead);
+
+	const std::string_view contents = index->storage.contents();
+	if (contents.size() >= sizeof(DictionaryFormat::MAGIC) &&
+	    std::memcmp(contents.data(), DictionaryFormat::MAGIC, sizeof(DictionaryFormat::MAGIC)) == 0)
+	{
+		index->loadBinary(fileToRead);
+	}
+	else
+	{
+		if (threads == 0)
+		{
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		index->loadText(threads);
+	}
+	index->buildRanking();
+	index->buildSamplers();
+	return index;
+}
+
+/**
+ * Indexes the mapped contents of a text word list, in parallel when it is
+ * large enough for every thread to get at least PARALLEL_CHUNK_SIZE bytes.
+ *
+ * @param threads The number of threads to parse with, at least 1.
+ */
+void WordIndex::loadText(const std::size_t threads)
+{
+	const std::string_view contents = storage.contents();
+	const std::size_t chunkCount = std::min(threads * 4, contents.size() / PARALLEL_CHUNK_SIZE);
+	if (threads == 1 || chunkCount < 2)
+	{
+		std::vector<std::uint32_t> lineWeights;
+		const std::vector<std::string_view> lines = splitLines(contents, lineWeights);
+		buildBuckets(lines, lineWeights);
+		return;
+	}
+	buildBucketsParallel(splitChunks(contents, contents.size() / chunkCount), threads);
+}
+
+/**
+ * Validates a compiled dictionary and indexes it in place. The letter masks and
+ * weights are used straight from the mapping; only the array of word views is
+ * built, and every mask is checked against its word.
+ *
+ * @param fileToRead Path to the dictionary file, used in error messages.
+ * @throws InvalidDictionaryException if the file fails validation.
+ */
+void WordIndex::loadBinary(const std::filesystem::path& fileToRead)
+{
+	const std::string_view contents = storage.contents();
+	const auto invalid = [&fileToRead](const std::string& reason) {
+		return InvalidDictionaryException(fileToRead.string(), reason);
+	};
+
+	if (contents.size() < sizeof(DictionaryFormat::Header))
+	{
+		throw invalid("truncated header");
+	}
+	DictionaryFormat::Header header{};
+	std::memcpy(&header, contents.data(), sizeof(header));
+	if (header.version != DictionaryFormat::VERSION && header.version != DictionaryFormat::WEIGHTED_VERSION)
+	{
+		throw invalid("unsupported version " + std::to_string(header.version));
+	}
+
+	// Check the section sizes before touching any of them
+	const bool hasWeights = header.version == DictionaryFormat::WEIGHTED_VERSION;
+	const std::uint64_t offsetsSize = (std::uint64_t{header.maxWordLength} + 2) * sizeof(std::uint64_t);
+	const std::uint64_t masksSize = header.wordCount * sizeof(LetterMask);
+	const std::uint64_t weightsSize = hasWeights ? header.wordCount * sizeof(std::uint32_t) : 0;
+	const std::uint64_t available = contents.size() - sizeof(header);
+	if (header.wordCount > available / (sizeof(LetterMask) + (hasWeights ? sizeof(std::uint32_t) : 0)) ||
+	    offsetsSize > available || offsetsSize + masksSize + weightsSize > available ||
+	    header.poolSize != available - offsetsSize - masksSize - weightsSize)
+	{
+		throw invalid("section sizes do not match the file size");
+	}
+
+	const char* const offsetsSection = contents.data() + sizeof(header);
+	const char* const masksSection = offsetsSection + offsetsSize;
+	const char* const weightsSection = masksSection + masksSize;
+	const char* const pool = weightsSection + weightsSize;
+
+	lengthOffsets.resize(header.maxWordLength + 2);
+	for (std::size_t length = 0; length < lengthOffsets.size(); ++length)
+	{
+		std::uint64_t offset = 0;
+		std::memcpy(&offset, offsetsSection + length * sizeof(offset), sizeof(offset));
+		lengthOffsets[length] = static_cast<std::size_t>(offset);
+	}
+
+	// Bucket boundaries must be ascending and cover exactly the pool
+	std::uint64_t poolBytes = 0;
+	if (lengthOffsets.front() != 0 || lengthOffsets.back() != header.wordCount)
+	{
+		throw invalid("length offsets do not cover every word");
+	}
+	for (std::size_t length = 0; length + 1 < lengthOffsets.size(); ++length)
+	{
+		if (lengthOffsets[length + 1] < lengthOffsets[length])
+		{
+			throw invalid("length offsets are not ascending");
+		}
+		poolBytes += (lengthOffsets[length + 1] - lengthOffsets[length]) * length;
+	}
+	if (poolBytes != header.poolSize)
+	{
+		throw invalid("string pool size does not match the length offsets");
+	}
+
+	masks = reinterpret_cast<const LetterMask*>(masksSection);
+	if (hasWeights)
+	{
+		weights = reinterpret_cast<const std::uint32_t*>(weightsSection);
+	}
+	indexPool(pool);
+
+	// The masks are used in place, so every one must be the mask of its word
+	for (std::size_t i = 0; i < words.size(); ++i)
+	{
+		if (masks[i] != letterMaskOf(words[i]))
+		{
+			throw invalid("letter mask of word " + std::to_string(i) + " does not match the word");
+		}
+	}
+}
+
+/**
+ * Indexes a dictionary compiled into the program. Nothing is read from disk;
+ * the words are views into the constant string pool.
+ *
+ * @param dictionary The generated dictionary tables.
+ * @return The shared, immutable index.
+ */
+std::shared_ptr<const WordIndex> WordIndex::fromEmbedded(const EmbeddedDictionary& dictionary)
+{
+	std::shared_ptr<WordIndex> index(new WordIndex());
+	index->lengthOffsets.assign(dictionary.lengthOffsets, dictionary.lengthOffsets + dictionary.lengthOffsetCount);
+	index->masks = dictionary.masks;
+	index->weights = dictionary.weights;
+	index->indexPool(dictionary.pool.data());
+	index->buildRanking();
+	index->buildSamplers();
+	return index;
+}
+
+/**
+ * Builds the word views over a string pool whose length buckets are dense
+ * arrays of fixed-size records, as described by `lengthOffsets`.
+ *
+ * @param pool The first byte of the string pool.
+ */
+void WordIndex::indexPool(const char* pool)
+{
+	words.resize(lengthOffsets.back());
+	const char* word = pool;
+	for (std::size_t length = 0; length + 1 < lengthOffsets.size(); ++length)
+	{
+		for (std::size_t i = lengthOffsets[length]; i < lengthOffsets[length + 1]; ++i)
+		{
+			words[i] = std::string_view(word, length);
+			word += length;
+		}
+	}
+}
+
+/**
+ * Writes the index as a compiled dictionary, see DictionaryFormat.h for the layout.
+ *
+ * @param fileToWrite Path of the compiled dictionary to create or replace.
+ * @throws InvalidDictionaryException if the file cannot be written.
+ */
+void WordIndex::writeBinary(const std::filesystem::path& fileToWrite) const
+{
+	std::ofstream file(fileToWrite, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		throw InvalidDictionaryException(fileToWrite.string(), "cannot be opened for writing");
+	}
+
+	DictionaryFormat::Header header{};
+	std::memcpy(header.magic, DictionaryFormat::MAGIC, sizeof(header.magic));
+	header.version = weighted() ? DictionaryFormat::WEIGHTED_VERSION : DictionaryFormat::VERSION;
+	header.maxWordLength = static_cast<std::uint32_t>(maxWordLength());
+	header.wordCount = words.size();
+	for (const auto word : words)
+	{
+		header.poolSize += word.size();
+	}
+
+	const std::vector<std::uint64_t> offsets(lengthOffsets.begin(), lengthOffsets.end());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(offsets.data()),
+	           static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+	file.write(reinterpret_cast<const char*>(masks), static_cast<std::streamsize>(words.size() * sizeof(LetterMask)));
+	if (weighted())
+	{
+		file.write(reinterpret_cast<const char*>(weights),
+		           static_cast<std::streamsize>(words.size() * sizeof(std::uint32_t)));
+	}
+	for (const auto word : words)
+	{
+		file.write(word.data(), static_cast<std::streamsize>(word.size()));
+	}
+
+	file.close();
+	if (!file)
+	{
+		throw InvalidDictionaryException(fileToWrite.string(), "could not be written");
+	}
+}
+
+/**
+ * Separates a trailing run of digits from a line. Only lines ending in a digit
+ * are inspected further, so plain word lists pay a single comparison per line.
+ *
+ * @param line A line without trailing whitespace, trimmed to the word if it has a weight column.
+ * @return The weight, or no value if the line has no weight column.
+ */
+std::optional<std::uint32_t> WordIndex::splitWeight(std::string_view& line)
+{
+	std::size_t digits = line.size();
+	while (digits > 0 && line[digits - 1] >= '0' && line[digits - 1] <= '9')
+	{
+		--digits;
+	}
+	if (digits == line.size() || digits == 0 || (line[digits - 1] != ' ' && line[digits - 1] != '\t'))
+	{
+		return std::nullopt;
+	}
+
+	std::size_t wordEnd = digits;
+	while (wordEnd > 0 && isTrailingWhitespace(line[wordEnd - 1]))
+	{
+		--wordEnd;
+	}
+	if (wordEnd == 0)
+	{
+		return std::nullopt; // only a number, that is the word
+	}
+
+	std::uint64_t weight = 0;
+	for (std::size_t i = digits; i < line.size(); ++i)
+	{
+		weight = std::min<std::uint64_t>(weight * 10 + static_cast<std::uint64_t>(line[i] - '0'),
+		                                 std::numeric_limits<std::uint32_t>::max());
+	}
+	line = line.substr(0, wordEnd);
+	return static_cast<std::uint32_t>(weight);
+}
+
+/**
+ * Splits text into lines, trimming trailing whitespace (including the '\r' of
+ * CRLF line endings), dropping empty lines and separating weight columns. Weights
+ * are only collected once the first weighted line shows up; the lines before it
+ * weigh 1.
+ *
+ * @param contents The text to split.
+ * @param lineWeights Receives the weight of every word, or stays empty if no line has a weight column.
+ * @return Views into contents, one per non-empty line, in order.
+ */
+std::vector<std::string_view> WordIndex::splitLines(const std::string_view contents,
+                                                    std::vector<std::uint32_t>& lineWeights)
+{
+	std::vector<std::string_view> lines;
+	const char* cursor = contents.data();
+	const char* const end = contents.data() + contents.size();
+
+	while (cursor < end)
+	{
+		const auto* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+		const char* lineEnd = newline != nullptr ? newline : end;
+
+		const char* wordEnd = lineEnd;
+		while (wordEnd > cursor && isTrailingWhitespace(wordEnd[-1]))
+		{
+			--wordEnd;
+		}
+		if (wordEnd > cursor)
+		{
+			std::string_view line(cursor, static_cast<std::size_t>(wordEnd - cursor));
+			const std::optional<std::uint32_t> weight = splitWeight(line);
+			if (!lineWeights.empty() || weight)
+			{
+				lineWeights.resize(lines.size(), 1);
+				lineWeights.push_back(weight.value_or(1));
+			}
+			lines.push_back(line);
+		}
+
+		cursor = lineEnd + 1;
+	}
+	return lines;
+}
+
+/**
+ * Groups the words by length with a counting sort, which keeps words of the
+ * same length in file order.
+ *
+ * @param unsortedWords The words in file order.
+ * @param unsortedWeights The weights of the words in file order, empty if unweighted.
+ */
+void WordIndex::buildBuckets(const std::vector<std::string_view>& unsortedWords,
+                             const std::vector<std::uint32_t>& unsortedWeights)
+{
+	std::size_t longest = 0;
+	for (const auto word : unsortedWords)
+	{
+		longest = std::max(longest, word.size());
+	}
+
+	// Count the words of every length, then turn the counts into bucket offsets
+	lengthOffsets.assign(longest + 2, 0);
+	for (const auto word : unsortedWords)
+	{
+		++lengthOffsets[word.size() + 1];
+	}
+	for (std::size_t length = 1; length < lengthOffsets.size(); ++length)
+	{
+		lengthOffsets[length] += lengthOffsets[length - 1];
+	}
+
+	std::vector<std::size_t> next(lengthOffsets.begin(), lengthOffsets.end() - 1);
+	words.resize(unsortedWords.size());
+	computedMasks.resize(unsortedWords.size());
+	computedWeights.resize(unsortedWeights.size());
+	for (std::size_t i = 0; i < unsortedWords.size(); ++i)
+	{
+		const std::string_view word = unsortedWords[i];
+		const std::size_t position = next[word.size()]++;
+		words[position] = word;
+		computedMasks[position] = letterMaskOf(word);
+		if (!unsortedWeights.empty())
+		{
+			computedWeights[position] = unsortedWeights[i];
+		}
+	}
+	masks = computedMasks.data();
+	weights = unsortedWeights.empty() ? nullptr : computedWeights.data();
+}
+
+/**
+ * Splits text into chunks of about chunkSize bytes, each extended to the end of
+ * the line it would otherwise cut.
+ *
+ * @param contents The text to split.
+ * @param chunkSize The target chunk size.
+ * @return The chunks, in order.
+ */
+std::vector<std::string_view> WordIndex::splitChunks(const std::string_view contents, const std::size_t chunkSize)
+{
+	std::vector<std::string_view> chunks;
+	std::size_t start = 0;
+	while (start < contents.size())
+	{
+		std::size_t end = std::min(start + chunkSize, contents.size());
+		if (end < contents.size())
+		{
+			const std::size_t newline = contents.find('\n', end);
+			end = newline == std::string_view::npos ? contents.size() : newline + 1;
+		}
+		chunks.push_back(contents.substr(start, end - start));
+		start = end;
+	}
+	return chunks;
+}
+
+/**
+ * Groups the words of a chunked word list by length with a parallel counting
+ * sort. Placing the words only needs every chunk's per-length counts, so the
+ * chunks never wait for each other and the order matches buildBuckets().
+ *
+ * @param chunks The chunks of the word list, in file order.
+ * @param threads The number of threads.
+ */
+void WordIndex::buildBucketsParallel(const std::vector<std::string_view>& chunks, const std::size_t threads)
+{
+	struct ChunkWords
+	{
+		std::vector<std::string_view> words;
+		std::vector<std::uint32_t> weights;
+		std::vector<std::size_t> lengthCounts;
+	};
+	std::vector<ChunkWords> parsed(chunks.size());
+	ThreadPool pool(threads);
+
+	for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
+	{
+		pool.submit([&chunks, &parsed, chunk] {
+			ChunkWords& result = parsed[chunk];
+			result.words = splitLines(chunks[chunk], result.weights);
+			for (const auto word : result.words)
+			{
+				if (word.size() >= result.lengthCounts.size())
+				{
+					result.lengthCounts.resize(word.size() + 1, 0);
+				}
+				++result.lengthCounts[word.size()];
+			}
+		});
+	}
+	pool.wait();
+
+	// Bucket offsets from the summed counts, as in buildBuckets()
+	std::size_t longest = 0;
+	for (const auto& result : parsed)
+	{
+		longest = std::max(longest, result.lengthCounts.size());
+	}
+	longest = longest == 0 ? 0 : longest - 1;
+	lengthOffsets.assign(longest + 2, 0);
+	for (const auto& result : parsed)
+	{
+		for (std::size_t length = 0; length < result.lengthCounts.size(); ++length)
+		{
+			lengthOffsets[length + 1] += result.lengthCounts[length];
+		}
+	}
+	for (std::size_t length = 1; length < lengthOffsets.size(); ++length)
+	{
+		lengthOffsets[length] += lengthOffsets[length - 1];
+	}
+
+	// Every chunk's words of a length follow those of the chunks before it
+	std::vector<std::vector<std::size_t>> firstPositions(chunks.size());
+	std::vector<std::size_t> next(lengthOffsets.begin(), lengthOffsets.end() - 1);
+	for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
+	{
+		firstPositions[chunk] = next;
+		for (std::size_t length = 0; length < parsed[chunk].lengthCounts.size(); ++length)
+		{
+			next[length] += parsed[chunk].lengthCounts[length];
+		}
+	}
+
+	// The index is weighted if any chunk is, the words of unweighted chunks weigh 1
+	const bool hasWeights =
+		std::any_of(parsed.begin(), parsed.end(), [](const ChunkWords& result) { return !result.weights.empty(); });
+
+	words.resize(lengthOffsets.back());
+	computedMasks.resize(lengthOffsets.back());
+	computedWeights.resize(hasWeights ? lengthOffsets.back() : 0);
+	for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
+	{
+		pool.submit([this, &parsed, &firstPositions, hasWeights, chunk] {
+			std::vector<std::size_t>& positions = firstPositions[chunk];
+			const ChunkWords& result = parsed[chunk];
+			for (std::size_t i = 0; i < result.words.size(); ++i)
+			{
+				const std::string_view word = result.words[i];
+				const std::size_t position = positions[word.size()]++;
+				words[position] = word;
+				computedMasks[position] = letterMaskOf(word);
+				if (hasWeights)
+				{
+					computedWeights[position] = result.weights.empty() ? 1 : result.weights[i];
+				}
+			}
+			parsed[chunk].words = {};
+			parsed[chunk].weights = {};
+		});
+	}
+	pool.wait();
+	masks = computedMasks.data();
+	weights = hasWeights ? computedWeights.data() : nullptr;
+}
+
+/**
+ * Scores every word against the other words of its length and ranks the
+ * playable ones. Per length, the share of words containing each letter gives
+ * both the letter's rarity and the order a frequency guesser tries letters in.
+ * A word's misses under that order are the letters ranked before its last
+ * letter that it does not contain.
+ */
+void WordIndex::buildRanking()
+{
+	scores.resize(words.size());
+	for (std::size_t length = 0; length + 1 < lengthOffsets.size(); ++length)
+	{
+		const std::size_t first = lengthOffsets[length];
+		const std::size_t last = lengthOffsets[length + 1];
+		if (first == last)
+		{
+			continue;
+		}
+
+		std::array<std::size_t, 26> containing{};
+		for (std::size_t i = first; i < last; ++i)
+		{
+			for (LetterMask mask = masks[i] & ALL_LETTERS_MASK; mask != 0; mask &= mask - 1)
+			{
+				++containing[static_cast<std::size_t>(__builtin_ctz(mask))];
+			}
+		}
+
+		std::array<int, 26> order{};
+		for (int letter = 0; letter < 26; ++letter)
+		{
+			order[static_cast<std::size_t>(letter)] = letter;
+		}
+		std::stable_sort(order.begin(), order.end(), [&containing](const int a, const int b) {
+			return containing[static_cast<std::size_t>(a)] > containing[static_cast<std::size_t>(b)];
+		});
+		std::array<int, 26> rank{};
+		std::array<float, 26> rarity{};
+		for (std::size_t position = 0; position < order.size(); ++position)
+		{
+			const auto letter = static_cast<std::size_t>(order[position]);
+			rank[letter] = static_cast<int>(position);
+			rarity[letter] = containing[letter] == 0
+			                     ? 0.0F
+			                     : std::log2(static_cast<float>(last - first) / static_cast<float>(containing[letter]));
+		}
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			// Only the 26 letter bits index the tables, whatever the mask holds
+			const LetterMask letters = masks[i] & ALL_LETTERS_MASK;
+			const int distinct = letterCount(letters);
+			if (distinct == 0)
+			{
+				scores[i] = 0.0F;
+				continue;
+			}
+			int lastRank = 0;
+			float raritySum = 0.0F;
+			for (LetterMask mask = letters; mask != 0; mask &= mask - 1)
+			{
+				const auto letter = static_cast<std::size_t>(__builtin_ctz(mask));
+				lastRank = std::max(lastRank, rank[letter]);
+				raritySum += rarity[letter];
+			}
+			const int misses = lastRank + 1 - distinct;
+			scores[i] = static_cast<float>(misses) + RARITY_WEIGHT * raritySum / static_cast<float>(distinct) +
+			            DISTINCT_LETTERS_WEIGHT / static_cast<float>(distinct);
+		}
+	}
+
+	// Sort keys of score and word number; the bits of a non-negative float order like the float itself
+	const std::size_t playable = lengthOffsets[std::min<std::size_t>(HARD_FILE_MAX_LENGTH, maxWordLength()) + 1];
+	std::vector<std::uint64_t> ranking(playable);
+	for (std::size_t i = 0; i < playable; ++i)
+	{
+		std::uint32_t scoreBits = 0;
+		std::memcpy(&scoreBits, &scores[i], sizeof(scoreBits));
+		ranking[i] = std::uint64_t{scoreBits} << 32 | i;
+	}
+
+	// Least significant digit radix sort on the score bits, a byte per pass; each
+	// pass is stable, so words of equal score stay in length order
+	std::vector<std::uint64_t> sorted(playable);
+	for (unsigned shift = 32; shift < 64; shift += 8)
+	{
+		std::array<std::size_t, 257> next{};
+		for (const std::uint64_t key : ranking)
+		{
+			++next[(key >> shift & 0xff) + 1];
+		}
+		for (std::size_t digit = 1; digit < next.size(); ++digit)
+		{
+			next[digit] += next[digit - 1];
+		}
+		for (const std::uint64_t key : ranking)
+		{
+			sorted[next[key >> shift & 0xff]++] = key;
+		}
+		ranking.swap(sorted);
+	}
+
+	rankedWords.resize(playable);
+	rankedMasks.resize(playable);
+	rankedScores.resize(playable);
+	rankedWeights.resize(weighted() ? playable : 0);
+	rankedNumbers.resize(playable);
+	for (std::size_t position = 0; position < playable; ++position)
+	{
+		const auto wordNumber = static_cast<std::size_t>(ranking[position] & 0xffffffffU);
+		rankedWords[position] = words[wordNumber];
+		rankedMasks[position] = masks[wordNumber];
+		rankedScores[position] = scores[wordNumber];
+		rankedNumbers[position] = static_cast<std::uint32_t>(wordNumber);
+		if (weighted())
+		{
+			rankedWeights[position] = weights[wordNumber];
+		}
+	}
+}
+
+/**
+ * Builds one alias table per difficulty level over the level's slice of the
+ * ranked weights, so that picking a word of a level by weight takes constant
+ * time. Unweighted indexes keep picking uniformly and need no tables.
+ */
+void WordIndex::buildSamplers()
+{
+	if (!weighted())
+	{
+		return;
+	}
+
+	samplers.reserve(3);
+	for (std::size_t tier = 0; tier < 3; ++tier)
+	{
+		const std::size_t first = rankedWords.size() * tier / 3;
+		const std::size_t last = rankedWords.size() * (tier + 1) / 3;
+		if (first == last)
+		{
+			continue;
+		}
+		samplers.push_back({rankedWords.data() + first, rankedWords.data() + last,
+		                    AliasTable(rankedWeights.data() + first, last - first)});
+	}
+}
+
+/**
+ * Builds a view over a slice of the length order or of the ranking and hands
+ * it the alias table that covers exactly the same words, if any.
+ *
+ * @param ranked True for the ranking, false for the length order.
+ * @param first The position of the first word of the slice.
+ * @param last The position one past the last word of the slice.
+ * @return The view.
+ */
+WordListView WordIndex::view(const bool ranked, const std::size_t first, const std::size_t last) const
+{
+	const std::string_view* const wordArray = ranked ? rankedWords.data() : words.data();
+	const AliasTable* sampler = nullptr;
+	for (const auto& candidate : samplers)
+	{
+		if (candidate.first == wordArray + first && candidate.last == wordArray + last)
+		{
+			sampler = &candidate.table;
+		}
+	}
+
+	if (ranked)
+	{
+		return {rankedWords.data() + first, rankedWords.data() + last, rankedMasks.data() + first,
+		        weighted() ? rankedWeights.data() + first : nullptr, rankedScores.data() + first, sampler,
+		        shared_from_this()};
+	}
+	return {words.data() + first, words.data() + last, masks + first, weighted() ? weights + first : nullptr,
+	        scores.data() + first, sampler, shared_from_this()};
+}
+
+/**
+ * Finds the number of a word from its place in either word array: the
+ * position itself in the length order, or the number recorded for it in the ranking.
+ *
+ * @param word A pointer into the words of a view of this index.
+ * @return The word's position in the length order.
+ */
+std::uint32_t WordIndex::wordNumber(const std::string_view* word) const
+{
+	if (word >= words.data() && word < words.data() + words.size())
+	{
+		return static_cast<std::uint32_t>(word - words.data());
+	}
+	return rankedNumbers[static_cast<std::size_t>(word - rankedWords.data())];
+}
+
+/**
+ * Hashes every word in length order, each followed by a newline, on the first call.
+ *
+ * @return A 32 bit FNV-1a hash of the words.
+ */
+std::uint32_t WordIndex::fingerprint() const
+{
+	std::call_once(fingerprintOnce, [this] {
+		std::uint32_t hash = 2166136261U;
+		for (const std::string_view word : words)
+		{
+			for (const char c : word)
+			{
+				hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+			}
+			hash = (hash ^ static_cast<unsigned char>('\n')) * 16777619U;
+		}
+		fingerprintValue = hash;
+	});
+	return fingerprintValue;
+}
+
+/**
+ * Identifies the word at the given position within its index.
+ *
+ * @param index Position of the word inside the view.
+ * @return The word's position in the index's length order.
+ */
+std::uint32_t WordListView::wordNumber(const std::size_t index) const
+{
+	return owner->wordNumber(first + index);
+}
+
+/**
+ * Retrieves all words whose length lies in [minLength, maxLength].
+ *
+ * @param minLength The minimum word length, inclusive.
+ * @param maxLength The maximum word length, inclusive.
+ * @return A view over the matching words, empty if there are none.
+ */
+WordListView WordIndex::wordsInRange(std::size_t minLength, std::size_t maxLength) const
+{
+	maxLength = std::min(maxLength, maxWordLength());
+	if (minLength > maxLength)
+	{
+		return {};
+	}
+	return view(false, lengthOffsets[minLength], lengthOffsets[maxLength + 1]);
+}
+
+/**
+ * Retrieves all words of exactly the given length.
+ *
+ * @param length The word length.
+ * @return A view over the matching words, empty if there are none.
+ */
+WordListView WordIndex::wordsOfLength(const std::size_t length) const
+{
+	return wordsInRange(length, length);
+}
+
+/**
+ * Retrieves the pattern index of a length bucket, building it on first use.
+ * The returned pointer aliases this index, so the bitsets outlive every caller
+ * the way the words outlive every view.
+ *
+ * @param length The word length.
+ * @return The index over the words of wordsOfLength(length).
+ */
+std::shared_ptr<const PatternIndex> WordIndex::patternIndex(const std::size_t length) const
+{
+	const std::lock_guard<std::mutex> lock(patternMutex);
+	if (patterns.size() <= length)
+	{
+		patterns.resize(length + 1);
+	}
+	if (!patterns[length])
+	{
+		patterns[length] = std::make_unique<const PatternIndex>(wordsOfLength(length));
+	}
+	return std::shared_ptr<const PatternIndex>(shared_from_this(), patterns[length].get());
+}
+
+/**
+ * Maps a difficulty level onto its third of the ranking.
+ *
+ * @param difficulty The difficulty level.
+ * @return A view over the matching words, empty for an unknown difficulty.
+ */
+WordListView WordIndex::forDifficulty(const WordDifficultyTypes difficulty) const
+{
+	switch (difficulty)
+	{
+	case WordDifficultyTypes::EASY:
+		return forTier(0, 3);
+	case WordDifficultyTypes::MEDIUM:
+		return forTier(1, 3);
+	case WordDifficultyTypes::HARD:
+		return forTier(2, 3);
+	default:
+		return {};
+	}
+}
+
+/**
+ * Slices the ranking into tierCount parts whose sizes differ by at most one word.
+ *
+ * @param tier The tier, 0 for the easiest.
+ * @param tierCount The number of tiers.
+ * @return A view over the words of the tier.
+ */
+WordListView WordIndex::forTier(const std::size_t tier, const std::size_t tierCount) const
+{
+	if (tier >= tierCount)
+	{
+		return {};
+	}
+	return view(true, rankedWords.size() * tier / tierCount, rankedWords.size() * (tier + 1) / tierCount);
+}
+
+/**
+ * Finds the score range in the ranking with two binary searches.
+ *
+ * @param minScore The minimum score, inclusive.
+ * @param maxScore The maximum score, inclusive.
+ * @return A view over the matching words.
+ */
+WordListView WordIndex::wordsByScore(const float minScore, const float maxScore) const
+{
+	if (!(minScore <= maxScore))
+	{
+		return {};
+	}
+	const auto first = std::lower_bound(rankedScores.begin(), rankedScores.end(), minScore);
+	const auto last = std::upper_bound(first, rankedScores.end(), maxScore);
+	return view(true, static_cast<std::size_t>(first - rankedScores.begin()),
+	            static_cast<std::size_t>(last - rankedScores.begin()));
+}
+
+/**
+ * Retrieves the word lengths belonging to a difficulty level.
+ *
+ * @param difficulty The difficulty level.
+ * @return The minimum and maximum length, inclusive.
+ */
+std::pair<std::size_t, std::size_t> WordIndex::lengthRange(const WordDifficultyTypes difficulty)
+{
+	switch (difficulty)
+	{
+	case WordDifficultyTypes::EASY:
+		return {1, EASY_FILE_MAX_LENGTH};
+	case WordDifficultyTypes::MEDIUM:
+		return {EASY_FILE_MAX_LENGTH + 1, MEDIUM_FILE_MAX_LENGTH};
+	case WordDifficultyTypes::HARD:
+		return {MEDIUM_FILE_MAX_LENGTH + 1, HARD_FILE_MAX_LENGTH};
+	default:
+		return {1, 0}; // Default case, should never happen if difficulty is properly validated
+	}
+}
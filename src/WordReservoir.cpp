@@ -0,0 +1,78 @@
+#include <WordReservoir.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * Constructs an empty reservoir.
+ *
+ * @param capacity The number of words to keep.
+ * @param random The random engine, must outlive the reservoir.
+ */
+WordReservoir::WordReservoir(const std::size_t capacity, RandomEngine& random) : capacity(capacity), random(random)
+{
+	samples.reserve(capacity);
+}
+
+/**
+ * Keeps the first `capacity` words, then replaces a random kept word at each
+ * scheduled position.
+ *
+ * @param word The word.
+ */
+void WordReservoir::offer(const std::string_view word)
+{
+	const std::uint64_t position = count++;
+	if (samples.size() < capacity)
+	{
+		samples.emplace_back(word);
+		if (samples.size() == capacity)
+		{
+			scheduleNext();
+		}
+		return;
+	}
+	if (position != next || capacity == 0)
+	{
+		return;
+	}
+
+	samples[static_cast<std::size_t>(random.below(capacity))].assign(word);
+	scheduleNext();
+}
+
+/**
+ * Shuffles the sample, so the words of a small stream do not come out in file order, and hands it out.
+ *
+ * @return The sampled words.
+ */
+std::vector<std::string> WordReservoir::take()
+{
+	std::shuffle(samples.begin(), samples.end(), random);
+	std::vector<std::string> result;
+	result.swap(samples);
+	samples.reserve(capacity);
+	count = 0;
+	weight = 1.0;
+	return result;
+}
+
+/**
+ * Advances the running key maximum and skips a geometrically distributed
+ * number of words.
+ */
+void WordReservoir::scheduleNext()
+{
+	const auto k = static_cast<double>(capacity);
+	// 1 - canonical() lies in (0, 1], so the logarithms stay finite
+	weight *= std::exp(std::log(1.0 - random.canonical()) / k);
+	const double skip = std::floor(std::log(1.0 - random.canonical()) / std::log1p(-weight));
+
+	if (!(skip < static_cast<double>(std::numeric_limits<std::uint64_t>::max() - count)))
+	{
+		next = std::numeric_limits<std::uint64_t>::max();
+		return;
+	}
+	next = count + static_cast<std::uint64_t>(skip);
+}
@@ -0,0 +1,366 @@
+#include <FileManager.h>
+#include <GameEngine.h>
+#include <GameManager.h>
+#include <PatternIndex.h>
+#include <RandomEngine.h>
+#include <WordIndex.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The outcome of one benchmark.
+ */
+struct BenchmarkResult
+{
+  std::string name;
+  std::uint64_t iterations{0};
+  double seconds{0.0};
+
+  /**
+   * @return The average time of one iteration in nanoseconds.
+   */
+  [[nodiscard]] double nanosecondsPerIteration() const
+  {
+    return iterations == 0 ? 0.0 : seconds * 1e9 / static_cast<double>(iterations);
+  }
+};
+
+/**
+ * @brief A benchmark body, running the measured operation the given number of times.
+ */
+using BenchmarkFunction = std::function<void(std::uint64_t iterations)>;
+
+/**
+ * @brief Discards everything written to it, standing in for the console.
+ */
+class NullBuffer final : public std::streambuf
+{
+protected:
+  int_type overflow(const int_type c) override { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char* /*s*/, const std::streamsize n) override { return n; }
+};
+
+/**
+ * @brief Points std::cout at another buffer and restores it when it goes out of scope.
+ */
+class StreamRedirect
+{
+public:
+  explicit StreamRedirect(std::streambuf* output) : savedOutput(std::cout.rdbuf(output)) {}
+
+  ~StreamRedirect() { std::cout.rdbuf(savedOutput); }
+
+  StreamRedirect(const StreamRedirect&) = delete;
+  StreamRedirect& operator=(const StreamRedirect&) = delete;
+
+private:
+  std::streambuf* savedOutput;
+};
+
+/**
+ * Keeps the compiler from optimizing away a value that is computed but never used.
+ *
+ * @param value The value to keep.
+ */
+template <typename T>
+static void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * Runs a benchmark with a growing number of iterations until one run takes at least minSeconds.
+ *
+ * @param name The name reported for the benchmark.
+ * @param minSeconds The minimum duration of the measured run.
+ * @param body The benchmark body.
+ * @return The measured run.
+ */
+static BenchmarkResult runBenchmark(const std::string& name, const double minSeconds, const BenchmarkFunction& body)
+{
+  BenchmarkResult result{name};
+  for (std::uint64_t iterations = 1;; iterations *= 2) {
+    const auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.iterations = iterations;
+    result.seconds = elapsed.count();
+    if (result.seconds >= minSeconds || iterations >= (std::uint64_t{1} << 40)) {
+      return result;
+    }
+    // Jump close to the target once a run is long enough to extrapolate from
+    if (result.seconds > minSeconds / 100) {
+      iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * 1.2 * minSeconds / result.seconds / 2) + 1;
+    }
+  }
+}
+
+/**
+ * Writes a synthetic dictionary of random lowercase words of 3 to 15 letters.
+ *
+ * @param path The file to write.
+ * @param words The number of words.
+ * @param seed The seed for the words.
+ */
+static void writeSyntheticDictionary(const std::filesystem::path& path, const std::uint64_t words, const std::uint64_t seed)
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot write " + path.string());
+  }
+
+  RandomEngine random(seed);
+  std::string line;
+  for (std::uint64_t i = 0; i < words; ++i) {
+    line.resize(static_cast<std::size_t>(random.between(3, 15)));
+    for (char& letter : line) {
+      letter = static_cast<char>('a' + random.below(26));
+    }
+    line += '\n';
+    file.write(line.data(), static_cast<std::streamsize>(line.size()));
+  }
+}
+
+/**
+ * Escapes a string for a JSON document.
+ *
+ * @param text The text to escape.
+ * @return The escaped text, without the surrounding quotes.
+ */
+static std::string jsonEscape(const std::string& text)
+{
+  std::string escaped;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+/**
+ * Prints the command-line usage.
+ *
+ * @param program The name the program was started with.
+ */
+static void printUsage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [options]\n"
+            << "  --words N           words in the synthetic dictionary (default 2000000)\n"
+            << "  --min-time S        minimum seconds per benchmark (default 0.5)\n"
+            << "  --filter TEXT       only run benchmarks whose name contains TEXT\n"
+            << "  --dictionary PATH   small word list to use (default: the game's dictionary)\n";
+}
+
+/**
+ * Benchmarks the paths the game and the simulations run at scale and writes
+ * the results to std::cout as JSON.
+ *
+ * The console output of the measured code goes to a null stream, so the
+ * benchmarks measure formatting but not the terminal.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return EXIT_SUCCESS after a successful run, EXIT_FAILURE on bad arguments or a missing dictionary.
+ */
+int main(int argc, char *argv[]) {
+  std::uint64_t syntheticWords = 2000000;
+  double minSeconds = 0.5;
+  std::string filter;
+  std::filesystem::path dictionary;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const char* option = argv[i];
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      const std::string value = argv[++i];
+
+      if (std::strcmp(option, "--words") == 0) {
+        syntheticWords = std::stoull(value);
+      } else if (std::strcmp(option, "--min-time") == 0) {
+        minSeconds = std::stod(value);
+      } else if (std::strcmp(option, "--filter") == 0) {
+        filter = value;
+      } else if (std::strcmp(option, "--dictionary") == 0) {
+        dictionary = value;
+      } else {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::logic_error&) {
+    // std::stoull and friends reject malformed numbers
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // The JSON goes to the real stdout, everything the game prints is discarded
+  std::ostream json(std::cout.rdbuf());
+  NullBuffer nullBuffer;
+  const StreamRedirect redirect(&nullBuffer);
+
+  const std::filesystem::path synthetic =
+      std::filesystem::temp_directory_path() / ("hangman_bench_" + std::to_string(RandomEngine::randomSeed()) + ".txt");
+  std::vector<BenchmarkResult> results;
+
+  try {
+    const FileManager fileManager;
+    const auto index = fileManager.getIndex(dictionary);
+    writeSyntheticDictionary(synthetic, syntheticWords, 1);
+
+    std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+
+    // Dictionary loading, parsed from scratch and served from the process-wide cache.
+    // Parsing the game's own text file is skipped when an embedded build does not ship it.
+    const std::filesystem::path smallPath =
+        dictionary.empty() ? std::filesystem::current_path() / ".." / "data" / "dictionary.txt" : dictionary;
+    if (std::filesystem::exists(smallPath)) {
+      benchmarks.emplace_back("WordIndex::load/small", [&](const std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+          doNotOptimize(WordIndex::load(smallPath));
+        }
+      });
+    }
+    benchmarks.emplace_back("WordIndex::load/synthetic", [&](const std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(WordIndex::load(synthetic));
+      }
+    });
+    benchmarks.emplace_back("FileManager::getWordList/small", [&](const std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(fileManager.getWordList(WordDifficultyTypes::MEDIUM, dictionary));
+      }
+    });
+    benchmarks.emplace_back("FileManager::getWordList/synthetic", [&](const std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(fileManager.getWordList(WordDifficultyTypes::MEDIUM, synthetic));
+      }
+    });
+
+    // Pattern queries over the largest length bucket, revealing two letters of its first word
+    const auto syntheticIndex = fileManager.getIndex(synthetic);
+    std::size_t bucketLength = 1;
+    for (std::size_t length = 2; length <= syntheticIndex->maxWordLength(); ++length) {
+      if (syntheticIndex->wordsOfLength(length).size() > syntheticIndex->wordsOfLength(bucketLength).size()) {
+        bucketLength = length;
+      }
+    }
+    const auto patterns = syntheticIndex->patternIndex(bucketLength);
+    std::string pattern(bucketLength, '_');
+    if (patterns->size() > 0 && bucketLength > 1) {
+      const std::string_view word = syntheticIndex->wordsOfLength(bucketLength)[0];
+      pattern[1] = word[1];
+      pattern[bucketLength - 1] = word[bucketLength - 1];
+    }
+    const LetterMask excluded = (letterBit('r') | letterBit('s')) & ~letterMaskOf(pattern);
+    benchmarks.emplace_back("PatternIndex::match/synthetic", [&](const std::uint64_t iterations) {
+      std::vector<std::uint64_t> matches;
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(patterns->match(pattern, excluded, matches));
+      }
+    });
+
+    // Word selection
+    benchmarks.emplace_back("RandomEngine::between", [&](const std::uint64_t iterations) {
+      RandomEngine random(1);
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(random.between(0, 9999));
+      }
+    });
+    benchmarks.emplace_back("GameEngine::newGame", [&](const std::uint64_t iterations) {
+      GameEngine engine(index);
+      engine.setSeed(1);
+      const WordListView words = index->forDifficulty(WordDifficultyTypes::MEDIUM);
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(engine.newGame(words));
+      }
+    });
+
+    // Guessing, on the engine alone and through the console front end
+    benchmarks.emplace_back("GameEngine::guess", [&](const std::uint64_t iterations) {
+      GameEngine engine(index);
+      engine.setSeed(1);
+      char letter = 'a';
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        if (engine.over() || letter > 'z') {
+          engine.newGame(WordDifficultyTypes::MEDIUM);
+          letter = 'a';
+        }
+        doNotOptimize(engine.guess(letter++));
+      }
+    });
+
+    GameManager game;
+    game.setSeed(1);
+    game.setPlayerName("bench");
+    game.begin();
+    game.consume("2\n");
+
+    benchmarks.emplace_back("GameManager::consume", [&](const std::uint64_t iterations) {
+      static constexpr std::string_view GUESSES = "etaoinshrdlcumwfgypbvkjxqz";
+      std::size_t next = 0;
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        if (game.turnState() == TurnState::PLAY_AGAIN) {
+          game.consume("y\n2\n");
+        }
+        doNotOptimize(game.consume(GUESSES.substr(next, 1)));
+        next = (next + 1) % GUESSES.size();
+      }
+    });
+    benchmarks.emplace_back("GameManager::didWin", [&](const std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(game.didWin());
+      }
+    });
+    benchmarks.emplace_back("GameManager::draw", [&](const std::uint64_t iterations) {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+        game.draw();
+      }
+    });
+
+    for (const auto& [name, body] : benchmarks) {
+      if (name.find(filter) != std::string::npos) {
+        results.push_back(runBenchmark(name, minSeconds, body));
+      }
+    }
+  } catch (const std::exception& e) {
+    std::filesystem::remove(synthetic);
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::filesystem::remove(synthetic);
+
+  json << "{\n  \"context\": {\"synthetic_words\": " << syntheticWords << ", \"min_time\": " << minSeconds
+       << "},\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const BenchmarkResult& result = results[i];
+    json << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << jsonEscape(result.name)
+         << "\", \"iterations\": " << result.iterations << ", \"real_time\": " << result.nanosecondsPerIteration()
+         << ", \"time_unit\": \"ns\"}";
+  }
+  json << "\n  ]\n}" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+#include <FileManager.h>
+#include <GameEngine.h>
+#include <Journal.h>
+#include <JournalFormat.h>
+#include <Metrics.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * Prints the command-line usage.
+ *
+ * @param program The name the program was started with.
+ */
+static void printUsage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [options] JOURNAL...\n"
+            << "  --dictionary PATH   word list the games were played with (default: the game's dictionary)\n"
+            << "Every game is played again with its recorded guesses and its outcome compared.\n";
+}
+
+/**
+ * @return The name of a recorded outcome.
+ */
+static const char* outcomeName(const GameStatus outcome)
+{
+  switch (outcome) {
+    case GameStatus::WON:
+      return "won";
+    case GameStatus::LOST:
+      return "lost";
+    case GameStatus::IN_PROGRESS:
+      return "abandoned";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * Replays game journals through the game engine at full speed and reports
+ * every game whose replayed outcome differs from the recorded one.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return EXIT_SUCCESS if every game replayed to its recorded outcome, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+  std::filesystem::path dictionary;
+  std::vector<std::filesystem::path> journals;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--dictionary") == 0 && i + 1 < argc) {
+      dictionary = argv[++i];
+    } else if (argv[i][0] != '-') {
+      journals.emplace_back(argv[i]);
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (journals.empty()) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // The replay is timed as a whole, per-game metrics would only slow it down
+  Metrics::setEnabled(false);
+
+  std::shared_ptr<const WordIndex> index;
+  try {
+    index = FileManager().getIndex(dictionary);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::uint32_t fingerprint = index->fingerprint();
+
+  std::uint64_t games = 0;
+  std::uint64_t guesses = 0;
+  std::uint64_t mismatches = 0;
+  std::uint64_t otherDictionary = 0;
+  bool failed = false;
+  double seconds = 0.0;
+
+  GameEngine engine;
+  JournalGame game;
+  for (const auto& path : journals) {
+    try {
+      JournalReader reader(path);
+      std::uint64_t number = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (; reader.next(game); ++number) {
+        std::string_view word = game.word;
+        if (game.wordNumber) {
+          // A word number only means something in the dictionary the game was played with
+          if (game.fingerprint != fingerprint || *game.wordNumber >= index->size()) {
+            ++otherDictionary;
+            continue;
+          }
+          word = index->word(*game.wordNumber);
+        }
+
+        engine.newGameWithWord(word);
+        for (const JournalGuess& guess : game.guesses) {
+          if (guess.letter == JournalFormat::TIMED_OUT) {
+            engine.timeOut();
+          } else {
+            engine.guess(guess.letter);
+          }
+        }
+        ++games;
+        guesses += game.guesses.size();
+
+        if (engine.status() != game.outcome) {
+          ++mismatches;
+          std::cerr << path.string() << ": game " << number << " (" << word << ") was "
+                    << outcomeName(game.outcome) << ", replayed " << outcomeName(engine.status()) << "\n";
+        }
+      }
+      seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (reader.truncated()) {
+        std::cerr << path.string() << ": stopped at a damaged or incomplete record after game " << number << "\n";
+      }
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      failed = true;
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << games << " games, " << guesses << " guesses replayed in " << seconds << " s, " << std::setprecision(0)
+            << (seconds > 0.0 ? static_cast<double>(guesses) / seconds : 0.0) << " guesses/s\n";
+  std::cout << mismatches << " mismatched outcomes";
+  if (otherDictionary > 0) {
+    std::cout << ", " << otherDictionary << " games skipped, played with another dictionary";
+  }
+  std::cout << "\n";
+
+  return failed || mismatches > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
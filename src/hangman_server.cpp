@@ -0,0 +1,148 @@
+#include <FileManager.h>
+#include <GameServer.h>
+#include <Metrics.h>
+#include <RandomEngine.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Prints the command-line usage.
+ *
+ * @param program The name the program was started with.
+ */
+static void printUsage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [options]\n"
+            << "  --host ADDRESS      IPv4 address to listen on (default 127.0.0.1)\n"
+            << "  --port N            TCP port, 0 for any free port (default 7777)\n"
+            << "  --unix PATH         listen on a Unix domain socket instead of TCP\n"
+            << "  --threads N         reactor threads, 0 for one per core (default 0)\n"
+            << "  --seed N            base seed, session i uses seed + i (default: random)\n"
+            << "  --dictionary PATH   word list to use (default: the game's dictionary)\n"
+            << "  --players DIR       keep player profiles and a leaderboard in this directory (default: none)\n"
+            << "  --journal PATH      append every game to this journal, see hangman_replay (default: none)\n"
+            << "The word list is reloaded when it changes on disk or on SIGHUP.\n"
+            << "SIGUSR1 prints the metrics in the Prometheus text format.\n"
+            << "Protocol, one request per line: NEW [easy|medium|hard], GUESS <letter>, STATE,\n"
+            << "  NAME <player>, PROFILE, TOP [count], METRICS, QUIT\n";
+}
+
+/**
+ * Serves Hangman sessions until SIGINT or SIGTERM, reloading the dictionary
+ * when its file changes and on SIGHUP, and printing the metrics on SIGUSR1.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return EXIT_SUCCESS after a clean shutdown, EXIT_FAILURE on bad arguments or startup errors.
+ */
+int main(int argc, char *argv[]) {
+  ServerConfig config;
+  config.seed = RandomEngine::randomSeed();
+  std::filesystem::path dictionary;
+  std::filesystem::path players;
+  std::filesystem::path journal;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const char* option = argv[i];
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      const std::string value = argv[++i];
+
+      if (std::strcmp(option, "--host") == 0) {
+        config.host = value;
+      } else if (std::strcmp(option, "--port") == 0) {
+        const unsigned long port = std::stoul(value);
+        if (port > 65535) {
+          throw std::out_of_range("port");
+        }
+        config.port = static_cast<std::uint16_t>(port);
+      } else if (std::strcmp(option, "--unix") == 0) {
+        config.unixSocket = value;
+      } else if (std::strcmp(option, "--threads") == 0) {
+        config.threads = std::stoul(value);
+      } else if (std::strcmp(option, "--seed") == 0) {
+        config.seed = std::stoull(value);
+      } else if (std::strcmp(option, "--dictionary") == 0) {
+        dictionary = value;
+      } else if (std::strcmp(option, "--players") == 0) {
+        players = value;
+      } else if (std::strcmp(option, "--journal") == 0) {
+        journal = value;
+      } else {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::logic_error&) {
+    // std::stoull and friends reject malformed numbers
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Block the signals before any thread starts, so only sigwait below receives them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigaddset(&signals, SIGHUP);
+  sigaddset(&signals, SIGUSR1);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  try {
+    const auto store = FileManager().getStore(dictionary);
+    store->watch();
+    config.dictionary = store;
+    if (!players.empty()) {
+      config.players = std::make_shared<PlayerStore>(players);
+      std::cout << "Loaded " << config.players->size() << " player profiles" << std::endl;
+
+      // Rank the stored players before the first game ends
+      config.leaderboard = std::make_shared<Leaderboard>();
+      config.players->forEach([&config](const std::string_view name, const PlayerProfile& profile) {
+        config.leaderboard->submit(name, profile.score);
+      });
+      config.leaderboard->refresh();
+    }
+    if (!journal.empty()) {
+      config.journal = std::make_shared<Journal>(journal);
+    }
+    GameServer server(config);
+    server.start();
+
+    if (config.unixSocket.empty()) {
+      std::cout << "Listening on " << config.host << ":" << server.port() << std::endl;
+    } else {
+      std::cout << "Listening on " << config.unixSocket.string() << std::endl;
+    }
+
+    for (int signal = SIGHUP; signal == SIGHUP || signal == SIGUSR1;) {
+      sigwait(&signals, &signal);
+      if (signal == SIGUSR1) {
+        std::cout << Metrics::snapshot().prometheus() << std::flush;
+      } else if (signal == SIGHUP) {
+        try {
+          store->reload();
+          std::cout << "Dictionary reloaded, " << store->snapshot()->size() << " words" << std::endl;
+        } catch (const std::exception& e) {
+          std::cerr << "Dictionary reload failed, keeping the current one: " << e.what() << std::endl;
+        }
+      }
+    }
+    std::cout << "Shutting down after " << server.sessionsAccepted() << " sessions" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
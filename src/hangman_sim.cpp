@@ -0,0 +1,137 @@
+#include <FileManager.h>
+#include <Metrics.h>
+#include <Simulator.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Prints the command-line usage.
+ *
+ * @param program The name the program was started with.
+ */
+static void printUsage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [options]\n"
+            << "  --games N           number of games to play (default 100000)\n"
+            << "  --threads N         worker threads, 0 for one per core (default 0)\n"
+            << "  --seed N            base seed, game i uses seed + i (default 0)\n"
+            << "  --difficulty D      easy, medium, hard or all (default all)\n"
+            << "  --strategy S        guessing strategy:";
+  for (const auto& name : guessStrategyNames()) {
+    std::cerr << " " << name;
+  }
+  std::cerr << " (default frequency)\n"
+            << "  --dictionary PATH   word list to use (default: the game's dictionary)\n"
+            << "  --metrics FORMAT    also print the metrics as json or prometheus\n"
+            << "  --journal PATH      append every game to this journal, see hangman_replay\n";
+}
+
+/**
+ * Plays a batch of automated games and reports throughput, win rate and
+ * average guesses per difficulty.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv An array of command-line argument strings.
+ * @return EXIT_SUCCESS after a successful run, EXIT_FAILURE on bad arguments or a missing dictionary.
+ */
+int main(int argc, char *argv[]) {
+  SimulationConfig config;
+  std::string strategyName = "frequency";
+  std::filesystem::path dictionary;
+  std::string metricsFormat;
+  std::filesystem::path journal;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const char* option = argv[i];
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      const std::string value = argv[++i];
+
+      if (std::strcmp(option, "--games") == 0) {
+        config.games = std::stoull(value);
+      } else if (std::strcmp(option, "--threads") == 0) {
+        config.threads = std::stoul(value);
+      } else if (std::strcmp(option, "--seed") == 0) {
+        config.seed = std::stoull(value);
+      } else if (std::strcmp(option, "--strategy") == 0) {
+        strategyName = value;
+      } else if (std::strcmp(option, "--dictionary") == 0) {
+        dictionary = value;
+      } else if (std::strcmp(option, "--metrics") == 0 && (value == "json" || value == "prometheus")) {
+        metricsFormat = value;
+      } else if (std::strcmp(option, "--journal") == 0) {
+        journal = value;
+      } else if (std::strcmp(option, "--difficulty") == 0 && value == "easy") {
+        config.difficulties = {WordDifficultyTypes::EASY};
+      } else if (std::strcmp(option, "--difficulty") == 0 && value == "medium") {
+        config.difficulties = {WordDifficultyTypes::MEDIUM};
+      } else if (std::strcmp(option, "--difficulty") == 0 && value == "hard") {
+        config.difficulties = {WordDifficultyTypes::HARD};
+      } else if (std::strcmp(option, "--difficulty") != 0 || value != "all") {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::logic_error&) {
+    // std::stoull and friends reject malformed numbers
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  config.strategy = makeGuessStrategyFactory(strategyName);
+  if (!config.strategy) {
+    std::cerr << "Unknown strategy: " << strategyName << std::endl;
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Timing millions of games a second would slow them down for nothing
+  Metrics::setEnabled(!metricsFormat.empty());
+
+  try {
+    config.dictionary = FileManager().getIndex(dictionary);
+    if (!journal.empty()) {
+      config.journal = std::make_shared<Journal>(journal);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const SimulationStats stats = Simulator::run(config);
+
+  static constexpr const char* DIFFICULTY_NAMES[] = {"easy", "medium", "hard"};
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "strategy " << strategyName << ", " << stats.total().games << " games in " << stats.seconds
+            << " s, " << std::setprecision(0) << stats.gamesPerSecond() << " games/s\n";
+  std::cout << std::setprecision(3);
+  std::cout << std::left << std::setw(10) << "difficulty" << std::right << std::setw(12) << "games"
+            << std::setw(10) << "win rate" << std::setw(14) << "avg guesses" << std::setw(14) << "avg misses"
+            << "\n";
+  for (std::size_t i = 0; i < stats.byDifficulty.size(); ++i) {
+    const DifficultyStats& row = stats.byDifficulty[i];
+    if (row.games == 0) {
+      continue;
+    }
+    std::cout << std::left << std::setw(10) << DIFFICULTY_NAMES[i] << std::right << std::setw(12) << row.games
+              << std::setw(10) << row.winRate() << std::setw(14) << row.averageGuesses() << std::setw(14)
+              << static_cast<double>(row.incorrectGuesses) / static_cast<double>(row.games) << "\n";
+  }
+
+  if (metricsFormat == "json") {
+    std::cout << Metrics::snapshot().json() << "\n";
+  } else if (metricsFormat == "prometheus") {
+    std::cout << Metrics::snapshot().prometheus();
+  }
+
+  return EXIT_SUCCESS;
+}
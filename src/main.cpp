@@ -1,46 +1,158 @@
+#include <ConsoleHost.h>
+#include <FileManager.h>
 #include <GameManager.h>
+#include <Metrics.h>
+#include <ScriptRunner.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <Trace.h>
 
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <unistd.h>
+#endif
+
+
+#ifdef HANGMAN_TRACING
+/**
+ * Writes the spans recorded during the session to the file named by the
+ * HANGMAN_TRACE_FILE environment variable, or hangman_trace.json.
+ */
+static void writeTrace() {
+  const char *path = std::getenv("HANGMAN_TRACE_FILE");
+  const std::filesystem::path traceFile = path != nullptr && *path != '\0' ? path : "hangman_trace.json";
+  if (!Tracer::writeChromeTrace(traceFile)) {
+    std::cerr << "Failed to write the trace to " << traceFile << std::endl;
+  }
+}
+#endif
+
+/**
+ * Opens the player store in the directory named by the HANGMAN_PLAYERS
+ * environment variable, or data/players.
+ *
+ * @return The store, nullptr if it cannot be opened, in which case profiles last for the session.
+ */
+static std::shared_ptr<PlayerStore> openPlayerStore() {
+  const char *path = std::getenv("HANGMAN_PLAYERS");
+  const std::filesystem::path directory = path != nullptr && *path != '\0' ? path : "data/players";
+  try {
+    return std::make_shared<PlayerStore>(directory);
+  } catch (const std::exception &e) {
+    std::cerr << "Player profiles will not be saved: " << e.what() << std::endl;
+    return nullptr;
+  }
+}
+
+/**
+ * Opens the journal named by the HANGMAN_JOURNAL environment variable.
+ *
+ * @return The journal, nullptr if the variable is not set or the journal cannot be opened.
+ */
+static std::shared_ptr<Journal> openJournal() {
+  const char *path = std::getenv("HANGMAN_JOURNAL");
+  if (path == nullptr || *path == '\0') {
+    return nullptr;
+  }
+  try {
+    return std::make_shared<Journal>(path);
+  } catch (const std::exception &e) {
+    std::cerr << "Games will not be journaled: " << e.what() << std::endl;
+    return nullptr;
+  }
+}
+
+/**
+ * Reads the time limit per answer from the HANGMAN_TURN_SECONDS environment variable.
+ *
+ * @return The limit, 0 for none when the variable is not set or not a positive number.
+ */
+static std::chrono::milliseconds turnTimeout() {
+  const char *seconds = std::getenv("HANGMAN_TURN_SECONDS");
+  if (seconds == nullptr) {
+    return std::chrono::milliseconds::zero();
+  }
+  const double value = std::strtod(seconds, nullptr);
+  return value > 0.0 ? std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(value * 1000.0))
+                     : std::chrono::milliseconds::zero();
+}
+
+/**
+ * Plays the games of a script without prompts, see ScriptRunner, writing the
+ * results to stdout. Games are journaled like interactive ones.
+ *
+ * @param path The script, "-" for stdin.
+ * @return EXIT_SUCCESS if every line of the script was executed, EXIT_FAILURE otherwise.
+ */
+static int runScript(const char *path) {
+  // Nothing reads the metrics of a script run, timing every guess would only slow it down
+  Metrics::setEnabled(false);
+
+  try {
+    ScriptRunner runner(FileManager().getIndex());
+    runner.setJournal(openJournal());
+
+    std::ifstream file;
+    if (std::strcmp(path, "-") != 0) {
+      file.open(path, std::ios::binary);
+      if (!file.is_open()) {
+        std::cerr << "Cannot open the script " << path << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    const ScriptStats stats = runner.run(file.is_open() ? file : std::cin, std::cout);
+    std::cout.flush();
+    return stats.errors == 0 && std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
 
 /**
  * The entry point of the application.
  *
+ * Without arguments the game is played on the console through a ConsoleHost,
+ * which waits for the player's input without blocking in the game and
+ * enforces the time limit, except on Windows, where turns are not timed. `--script [FILE]` plays the games of a script
+ * instead, from FILE or stdin.
+ *
  * @param argc The number of command-line arguments.
  * @param argv An array of command-line argument strings.
  * @return An integer representing the exit status of the program.
  */
 int main(int argc, char *argv[]) {
-  // Create a GameManager instance with a specific difficulty
-  const auto gameManager = std::make_unique<GameManager>();
-  std::string name_;
-  std::cout << "Welcome to Hangman - the classic word guessing game" << std::endl;
-  std::cout << "Apologize for being personal but what is your name? ";
-  std::cin >> name_;
-  std::cout << std::endl;
-
-  gameManager->start();
-
-  // Main game loop
-for (;;)
-{
-  gameManager->setPlayerName(name_);
-  gameManager->draw();   // Draw the game state
-  gameManager->menu();   // Show the menu for input (e.g., player guesses)
-
-  // Check if the player has won
-  if (gameManager->didWin()) {
-    std::cout << "You win! You guessed the word - " << gameManager->getTargetWord()  << std::endl;
-  }
-  if (gameManager->getAttemptsLeft() == 0) {
-    std::cout << "You lose! The word was - " << gameManager->getTargetWord() << std::endl;
+  if (argc > 1) {
+    if (std::strcmp(argv[1], "--script") != 0 || argc > 3) {
+      std::cerr << "Usage: " << argv[0] << " [--script [FILE]]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    return runScript(argc == 3 ? argv[2] : "-");
   }
 
-  if (gameManager->gameOver())
-  {
-    gameManager->playAgain();  // Ask if the player wants to play again
+  ConsoleHost host(turnTimeout());
+#ifdef _WIN32
+  GameManager &gameManager = host.add(_fileno(stdin), _fileno(stdout));
+#else
+  GameManager &gameManager = host.add(STDIN_FILENO, STDOUT_FILENO);
+#endif
+  gameManager.setPlayerStore(openPlayerStore());
+  gameManager.setJournal(openJournal());
+
+  try {
+    host.run();
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
   }
-}
 
-  // unreachable code - the clang tidy static analyzer errors if main is void
+#ifdef HANGMAN_TRACING
+  writeTrace();
+#endif
   return 0;
 }